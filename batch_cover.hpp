@@ -0,0 +1,153 @@
+#ifndef BATCH_EDGE_COVER_HPP
+#define BATCH_EDGE_COVER_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include "graph.hpp"
+
+// one graph of a batch; the edges stay owned by the caller
+struct GraphRef {
+    int n = 0;
+    const Edge* edges = nullptr;
+    size_t edgeCount = 0;
+
+    GraphRef() = default;
+    GraphRef(int n, const Edge* edges, size_t edgeCount) : n(n), edges(edges), edgeCount(edgeCount) {}
+    GraphRef(int n, const std::vector<Edge>& edges) : n(n), edges(edges.data()), edgeCount(edges.size()) {}
+};
+
+// Minimum edge covers of many small graphs. The graphs are spread over
+// options.threads workers, and each worker solves its share one after the
+// other with a single MinEdgeCover that it assign()s every graph to. The
+// calling thread is worker 0; the others are threads started with the
+// BatchCoverSolver that sleep between batches, so a solve() of a few
+// graphs costs a wake-up rather than a thread start per worker. The
+// solvers live as long as the BatchCoverSolver, and so do the cover
+// vectors the caller passes in, so once the largest graph has been seen a
+// batch runs without any heap allocation per graph. One solve() runs at a
+// time.
+class BatchCoverSolver {
+private:
+    SolverOptions options;
+    std::vector<MinEdgeCover> workers;
+
+    // graphs a worker takes from the shared counter at a time
+    static constexpr size_t chunk = 32;
+
+    // the batch in progress, set under lock before the helpers wake
+    const GraphRef* batchGraphs = nullptr;
+    size_t batchSize = 0;
+    std::vector<std::vector<Edge>>* batchCovers = nullptr;
+    std::atomic<size_t> next{0};
+    size_t failed = 0;          // first failing graph, batchSize if none
+    std::string reason;
+
+    std::mutex lock;
+    std::condition_variable wake, finished;
+    uint64_t batch = 0;         // bumped for every batch the helpers take part in
+    unsigned busy = 0;          // helpers still working on it
+    bool closing = false;
+    std::vector<std::thread> helpers;       // workers 1 .. n - 1
+
+    void drain(unsigned w) {
+        MinEdgeCover& solver = workers[w];
+        for (;;) {
+            size_t begin = next.fetch_add(chunk, std::memory_order_relaxed);
+            if (begin >= batchSize) return;
+            size_t end = std::min(begin + chunk, batchSize);
+            for (size_t i = begin; i < end; i++) {
+                try {
+                    solver.assign(batchGraphs[i].n, batchGraphs[i].edges, batchGraphs[i].edgeCount);
+                    solver.solveInto((*batchCovers)[i]);
+                } catch (const std::exception& e) {
+                    (*batchCovers)[i].clear();
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (i < failed) {
+                        failed = i;
+                        reason = e.what();
+                    }
+                }
+            }
+        }
+    }
+
+    void help(unsigned w) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&] { return closing || batch != seen; });
+                if (closing) return;
+                seen = batch;
+            }
+            drain(w);
+            std::lock_guard<std::mutex> guard(lock);
+            if (--busy == 0) finished.notify_one();
+        }
+    }
+
+public:
+    explicit BatchCoverSolver(SolverOptions options = {}) : options(options) {
+        SolverOptions perGraph = options;
+        perGraph.threads = 1;
+        unsigned count = resolveThreads(options.threads);
+        workers.assign(count, MinEdgeCover(perGraph));
+        helpers.reserve(count - 1);
+        for (unsigned w = 1; w < count; w++) {
+            helpers.emplace_back(&BatchCoverSolver::help, this, w);
+        }
+    }
+
+    BatchCoverSolver(const BatchCoverSolver&) = delete;
+    BatchCoverSolver& operator=(const BatchCoverSolver&) = delete;
+
+    ~BatchCoverSolver() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closing = true;
+        }
+        wake.notify_all();
+        for (auto& t : helpers) {
+            t.join();
+        }
+    }
+
+    // covers[i] receives the cover of graphs[i]. Every graph is solved even
+    // if some fail; the first failing graph is then reported as
+    // std::invalid_argument, and its cover is left empty
+    void solve(const GraphRef* graphs, size_t count, std::vector<std::vector<Edge>>& covers) {
+        covers.resize(count);
+        // a batch of one chunk is not worth waking anyone for
+        bool shared = !helpers.empty() && count > chunk;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            batchGraphs = graphs;
+            batchSize = count;
+            batchCovers = &covers;
+            next.store(0, std::memory_order_relaxed);
+            failed = count;
+            reason.clear();
+            if (shared) {
+                busy = static_cast<unsigned>(helpers.size());
+                batch++;
+            }
+        }
+        if (shared) wake.notify_all();
+        drain(0);
+        if (shared) {
+            std::unique_lock<std::mutex> guard(lock);
+            finished.wait(guard, [&] { return busy == 0; });
+        }
+
+        if (failed != count) {
+            throw std::invalid_argument("Graph " + std::to_string(failed) + " of the batch: " + reason);
+        }
+    }
+
+    void solve(const std::vector<GraphRef>& graphs, std::vector<std::vector<Edge>>& covers) {
+        solve(graphs.data(), graphs.size(), covers);
+    }
+};
+
+#endif // BATCH_EDGE_COVER_HPP
@@ -0,0 +1,405 @@
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "cover_verifier.hpp"
+#include "graph.hpp"
+#include "weighted_cover.hpp"
+
+// Scalability benchmark for the C++ solver. It generates the graph families
+// of comparison.py at up to millions of vertices and runs every engine that
+// applies to each graph, plus the weighted solver on random integer costs,
+// so the price of the weighted mode shows next to the unweighted engines.
+// Every run happens in a forked child, so the peak RSS reported is that of
+// the run alone. A run that exceeds the timeout is killed, and larger sizes
+// of that family are skipped for its engine. The JSON output has the shape
+// plot_scalability() in comparison.py expects:
+// { family: [ {n, m, cover_size, time_ms, ...}, ... ] }.
+//
+// With --reorder the unweighted engines solve with that SolverOptions::
+// reorder, and each record also holds the time of the same solve on the
+// input order (baseline_ms) and the speedup over it; --ids shuffled
+// renames the generated vertices at random first, as real inputs often are.
+// --epsilon sets SolverOptions::epsilon and adds the gap_bound of each
+// result; only results with no gap left are then certified.
+//
+// --churn C replays a snapshot workload: after the measured solve, a share C
+// of the edges is rewired by degree-preserving swaps, and the changed graph
+// is solved twice, from scratch (cold_ms) and warm-started from the cover
+// just found (warm_ms), with the seed pairs the warm solve kept and dropped
+// and the cover edges that did not become pairs.
+
+struct BenchConfig {
+    int maxN = 1000000;
+    int maxComplete = 4000;     // K_n has n^2 / 2 edges, so it stops earlier
+    unsigned threads = 1;
+    int timeoutSeconds = 60;
+    std::string output = "benchmark.json";
+    std::string families = "sparse,dense,complete,bipartite,grid,cycle";
+    VertexOrder reorder = VertexOrder::Input;
+    bool shuffleIds = false;
+    double epsilon = 0;
+    double churn = 0;
+};
+
+VertexOrder parseOrder(const std::string& name) {
+    for (VertexOrder order : {VertexOrder::Input, VertexOrder::Degree, VertexOrder::BFS,
+                              VertexOrder::ReverseCuthillMcKee}) {
+        if (name == orderName(order)) return order;
+    }
+    throw std::invalid_argument("Unknown vertex order: " + name);
+}
+
+// renames the vertices by a random permutation
+void shuffleIds(int n, std::vector<Edge>& edges) {
+    std::mt19937_64 rng(11);
+    std::vector<int> name(n);
+    for (int v = 0; v < n; v++) name[v] = v;
+    std::shuffle(name.begin(), name.end(), rng);
+    for (Edge& e : edges) e = Edge(name[e.u], name[e.v]);
+}
+
+// every vertex gets an edge to an earlier one, as in generate_random_graph
+void spanningTree(int n, std::mt19937_64& rng, std::vector<Edge>& edges) {
+    for (int i = 1; i < n; i++) {
+        edges.push_back(Edge(static_cast<int>(rng() % i), i));
+    }
+}
+
+void randomEdges(int n, size_t count, std::mt19937_64& rng, std::vector<Edge>& edges) {
+    for (size_t k = 0; k < count; k++) {
+        int u = static_cast<int>(rng() % n), v = static_cast<int>(rng() % n);
+        if (u != v) edges.push_back(Edge(u, v));
+    }
+}
+
+// fills edges for a graph of about n vertices, returns the exact vertex count
+int generate(const std::string& family, int n, std::vector<Edge>& edges) {
+    std::mt19937_64 rng(42);
+    if (family == "sparse") {
+        // constant average degree (about 8) instead of edge_prob, so the
+        // family still scales at millions of vertices
+        spanningTree(n, rng, edges);
+        randomEdges(n, 3 * static_cast<size_t>(n), rng, edges);
+    } else if (family == "dense") {
+        spanningTree(n, rng, edges);
+        randomEdges(n, 32 * static_cast<size_t>(n), rng, edges);
+    } else if (family == "complete") {
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) {
+                edges.push_back(Edge(i, j));
+            }
+        }
+    } else if (family == "bipartite") {
+        int n1 = n / 2, n2 = n - n1;
+        for (int i = 0; i < n1; i++) edges.push_back(Edge(i, n1 + static_cast<int>(rng() % n2)));
+        for (int j = 0; j < n2; j++) edges.push_back(Edge(static_cast<int>(rng() % n1), n1 + j));
+        for (size_t k = 0; k < 3 * static_cast<size_t>(n); k++) {
+            edges.push_back(Edge(static_cast<int>(rng() % n1), n1 + static_cast<int>(rng() % n2)));
+        }
+    } else if (family == "grid") {
+        int side = std::max(2, static_cast<int>(std::sqrt(static_cast<double>(n))));
+        n = side * side;
+        for (int i = 0; i < side; i++) {
+            for (int j = 0; j < side; j++) {
+                int node = i * side + j;
+                if (j < side - 1) edges.push_back(Edge(node, node + 1));
+                if (i < side - 1) edges.push_back(Edge(node, node + side));
+            }
+        }
+    } else if (family == "cycle") {
+        // cycle with n / 2 random chords, the ratio comparison.py uses
+        for (int i = 0; i < n; i++) edges.push_back(Edge(i, (i + 1) % n));
+        randomEdges(n, static_cast<size_t>(n) / 2, rng, edges);
+    } else {
+        throw std::invalid_argument("Unknown graph family: " + family);
+    }
+    return n;
+}
+
+// Rewires about share * |edges| edges: each swap turns (a, b), (c, d)
+// into (a, d), (c, b), which keeps every degree, so no vertex is left
+// isolated, and keeps a bipartite graph with its edges listed left to
+// right bipartite. Swaps that would make a self-loop are skipped
+void rewire(std::vector<Edge>& edges, double share) {
+    std::mt19937_64 rng(23);
+    size_t swaps = static_cast<size_t>(share * static_cast<double>(edges.size()) / 2);
+    for (size_t k = 0; k < swaps && edges.size() > 1; k++) {
+        Edge& x = edges[rng() % edges.size()];
+        Edge& y = edges[rng() % edges.size()];
+        if (x.u == y.v || y.u == x.v) continue;
+        std::swap(x.v, y.v);
+    }
+}
+
+double millis(std::chrono::nanoseconds t) {
+    return std::chrono::duration<double, std::milli>(t).count();
+}
+
+// the same graph with costs drawn uniformly from 1 .. 1000
+std::string measureWeighted(int n, const std::vector<Edge>& edges) {
+    std::mt19937_64 rng(7);
+    std::vector<WeightedEdge> weighted;
+    weighted.reserve(edges.size());
+    for (const auto& e : edges) {
+        weighted.push_back(WeightedEdge(e.u, e.v, 1 + static_cast<int64_t>(rng() % 1000)));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    WeightedMinEdgeCover solver(n, weighted);
+    auto built = std::chrono::steady_clock::now();
+
+    WeightedCoverResult result = solver.solveDetailed();
+    if (!WeightedMinEdgeCover::isEdgeCover(n, result.edges)) {
+        throw std::runtime_error("Invalid cover");
+    }
+
+    std::ostringstream json;
+    json << "{\"n\": " << n << ", \"m\": " << edges.size() << ", \"engine\": \"weighted\", \"threads\": 1"
+         << ", \"cover_size\": " << result.edges.size() << ", \"cover_weight\": " << result.weight
+         << ", \"matching_size\": " << result.matchingSize
+         << ", \"build_ms\": " << millis(built - start)
+         << ", \"matching_ms\": " << millis(result.matchingTime)
+         << ", \"completion_ms\": " << millis(result.completionTime)
+         << ", \"time_ms\": " << millis(result.matchingTime + result.completionTime);
+    return json.str();
+}
+
+// engines the benchmark runs; weighted rows use WeightedMinEdgeCover
+struct BenchEngine {
+    const char* name;
+    MatchingEngine engine;
+    bool weighted;
+};
+
+// Runs one (family, n, engine) measurement and returns its JSON record
+// without peak_rss_kb, or an empty string if the engine does not apply
+std::string measure(const std::string& family, int n, const BenchEngine& bench, const BenchConfig& config) {
+    unsigned threads = config.threads;
+    std::vector<Edge> edges;
+    n = generate(family, n, edges);
+    if (config.shuffleIds) shuffleIds(n, edges);
+    if (bench.weighted) return measureWeighted(n, edges);
+    MatchingEngine engine = bench.engine;
+
+    SolverOptions options;
+    options.engine = engine;
+    options.threads = threads;
+    if (engine == MatchingEngine::HopcroftKarp && !MinEdgeCover(n, edges).isBipartite()) return "";
+
+    // the same solve on the input order first, for the speedup
+    bool reordering = config.reorder != VertexOrder::Input;
+    std::chrono::nanoseconds baseline{0};
+    if (reordering) {
+        MinEdgeCover plain(n, edges, options);
+        CoverResult first = plain.solveDetailed();
+        baseline = first.matchingTime + first.completionTime;
+    }
+    options.reorder = config.reorder;
+    options.epsilon = config.epsilon;
+
+    auto start = std::chrono::steady_clock::now();
+    MinEdgeCover solver(n, edges, options);
+    auto built = std::chrono::steady_clock::now();
+
+    SolveStats stats;
+    CoverResult result = reordering ? solver.solveDetailed(stats) : solver.solveDetailed();
+
+    // exact results are also proven minimum, greedy and approximate ones
+    // only checked
+    bool exact = engine != MatchingEngine::Greedy && result.gapBound == 0;
+    auto certifyStart = std::chrono::steady_clock::now();
+    MatchingCertificate proof;
+    if (exact) proof = solver.certificate();
+    auto certified = std::chrono::steady_clock::now();
+    VerifyReport check = CoverVerifier::verify(solver.csr(), result.edges, exact ? &proof : nullptr, threads);
+    if (!check.valid || (exact && !check.optimal)) {
+        throw std::runtime_error("Invalid cover");
+    }
+
+    std::ostringstream json;
+    json << "{\"n\": " << n << ", \"m\": " << edges.size()
+         << ", \"engine\": \"" << engineName(result.engine) << "\", \"threads\": " << resolveThreads(threads)
+         << ", \"cover_size\": " << result.edges.size() << ", \"matching_size\": " << result.matchingSize
+         << ", \"augmentations\": " << result.augmentations
+         << ", \"build_ms\": " << millis(built - start)
+         << ", \"matching_ms\": " << millis(result.matchingTime)
+         << ", \"completion_ms\": " << millis(result.completionTime)
+         << ", \"time_ms\": " << millis(result.matchingTime + result.completionTime)
+         << ", \"certificate_ms\": " << millis(certified - certifyStart)
+         << ", \"verify_ms\": " << millis(check.time);
+    if (config.epsilon > 0) {
+        json << ", \"epsilon\": " << config.epsilon << ", \"gap_bound\": " << result.gapBound;
+    }
+    if (reordering) {
+        auto total = result.matchingTime + result.completionTime;
+        json << ", \"reorder\": \"" << orderName(config.reorder) << "\""
+             << ", \"reorder_ms\": " << millis(stats.reorderTime)
+             << ", \"baseline_ms\": " << millis(baseline)
+             << ", \"speedup\": " << millis(baseline) / std::max(millis(total), 1e-6);
+    }
+    if (config.churn > 0) {
+        std::vector<Edge> changed = edges;
+        rewire(changed, config.churn);
+        MinEdgeCover cold(n, changed, options), warm(n, changed, options);
+        if (engine == MatchingEngine::HopcroftKarp && !cold.isBipartite()) return json.str();
+        CoverResult fresh = cold.solveDetailed();
+        warm.warmStartFrom(result.edges);
+        CoverResult seeded = warm.solveDetailed();
+        if (exact && fresh.gapBound == 0 && seeded.gapBound == 0 && fresh.edges.size() != seeded.edges.size()) {
+            throw std::runtime_error("Warm start changed the cover size");
+        }
+        auto coldTime = fresh.matchingTime + fresh.completionTime;
+        auto warmTime = seeded.matchingTime + seeded.completionTime;
+        json << ", \"churn\": " << config.churn
+             << ", \"cold_ms\": " << millis(coldTime)
+             << ", \"warm_ms\": " << millis(warmTime)
+             << ", \"warm_speedup\": " << millis(coldTime) / std::max(millis(warmTime), 1e-6)
+             << ", \"seed_kept\": " << seeded.seedKept << ", \"seed_dropped\": " << seeded.seedDropped
+             << ", \"seed_unpaired\": " << seeded.seedUnpaired;
+    }
+    return json.str();
+}
+
+// forks a child for one measurement; returns false on timeout or failure
+bool runIsolated(const std::string& family, int n, const BenchEngine& engine, const BenchConfig& config,
+                 std::string& record) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw std::runtime_error("pipe failed");
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error("fork failed");
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        alarm(static_cast<unsigned>(config.timeoutSeconds));
+        int status = 0;
+        try {
+            std::string json = measure(family, n, engine, config);
+            if (write(fds[1], json.data(), json.size()) != static_cast<ssize_t>(json.size())) status = 1;
+        } catch (const std::exception& e) {
+            std::cerr << "  " << family << " n=" << n << ": " << e.what() << std::endl;
+            status = 1;
+        }
+        close(fds[1]);
+        _exit(status);
+    }
+
+    close(fds[1]);
+    record.clear();
+    char buffer[4096];
+    ssize_t got;
+    while ((got = read(fds[0], buffer, sizeof(buffer))) > 0) {
+        record.append(buffer, static_cast<size_t>(got));
+    }
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    if (WIFSIGNALED(status)) {
+        std::cerr << "  " << family << " n=" << n << " " << engine.name
+                  << (WTERMSIG(status) == SIGALRM ? ": timed out" : ": killed") << std::endl;
+        return false;
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return false;
+    if (!record.empty()) {
+        // ru_maxrss is in kilobytes on Linux
+        record += ", \"peak_rss_kb\": " + std::to_string(usage.ru_maxrss) + "}";
+    }
+    return true;
+}
+
+std::vector<int> sizesFor(const std::string& family, const BenchConfig& config) {
+    int limit = family == "complete" ? config.maxComplete : config.maxN;
+    std::vector<int> sizes;
+    for (long long base = family == "complete" ? 10 : 1000; base <= limit; base *= 10) {
+        sizes.push_back(static_cast<int>(base));
+        if (3 * base <= limit) sizes.push_back(static_cast<int>(3 * base));
+    }
+    return sizes;
+}
+
+void usage() {
+    std::cerr << "Usage: benchmark [--max-n N] [--max-complete N] [--threads T] [--timeout S]" << std::endl;
+    std::cerr << "                 [--families sparse,dense,complete,bipartite,grid,cycle] [--out file.json]" << std::endl;
+    std::cerr << "                 [--reorder input|degree|bfs|rcm] [--ids input|shuffled] [--epsilon E]" << std::endl;
+    std::cerr << "                 [--churn C]" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--max-n") config.maxN = std::stoi(value);
+        else if (arg == "--max-complete") config.maxComplete = std::stoi(value);
+        else if (arg == "--threads") config.threads = static_cast<unsigned>(std::stoul(value));
+        else if (arg == "--timeout") config.timeoutSeconds = std::stoi(value);
+        else if (arg == "--families") config.families = value;
+        else if (arg == "--out") config.output = value;
+        else if (arg == "--reorder") config.reorder = parseOrder(value);
+        else if (arg == "--epsilon") config.epsilon = std::stod(value);
+        else if (arg == "--churn") config.churn = std::stod(value);
+        else if (arg == "--ids" && (value == "input" || value == "shuffled")) config.shuffleIds = value == "shuffled";
+        else {
+            usage();
+            return 1;
+        }
+    }
+
+    const BenchEngine engines[] = {
+        {"blossom", MatchingEngine::Blossom, false},
+        {"hopcroft-karp", MatchingEngine::HopcroftKarp, false},
+        {"greedy", MatchingEngine::Greedy, false},
+        {"weighted", MatchingEngine::Auto, true},
+    };
+
+    std::ostringstream json;
+    json << "{";
+    std::stringstream names(config.families);
+    std::string family;
+    bool firstFamily = true;
+    while (std::getline(names, family, ',')) {
+        std::cerr << "Family " << family << ":" << std::endl;
+        json << (firstFamily ? "" : ",") << "\n  \"" << family << "\": [";
+        firstFamily = false;
+        bool firstRecord = true;
+        for (const BenchEngine& engine : engines) {
+            for (int n : sizesFor(family, config)) {
+                std::string record;
+                if (!runIsolated(family, n, engine, config, record)) break;
+                if (record.empty()) break;   // engine does not apply to this family
+                json << (firstRecord ? "" : ",") << "\n    " << record;
+                firstRecord = false;
+                std::cerr << "  " << engine.name << " n=" << n << " done" << std::endl;
+            }
+        }
+        json << "\n  ]";
+    }
+    json << "\n}\n";
+
+    FILE* out = std::fopen(config.output.c_str(), "w");
+    if (out == nullptr) {
+        std::cerr << "Failed to open file for writing: " << config.output << std::endl;
+        return 1;
+    }
+    std::string text = json.str();
+    std::fwrite(text.data(), 1, text.size(), out);
+    std::fclose(out);
+    std::cerr << "Results saved to " << config.output << std::endl;
+    return 0;
+}
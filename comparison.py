@@ -3,6 +3,8 @@
 
 import networkx as nx
 import time
+import json
+import sys
 import random
 import matplotlib.pyplot as plt
 from tabulate import tabulate
@@ -270,7 +272,18 @@ def benchmark_scalability():
 
     return results
 
-def plot_scalability(results):
+def load_cpp_benchmark(filename):
+    """Load the JSON written by the C++ benchmark, one series per family and engine"""
+    with open(filename, 'r') as f:
+        data = json.load(f)
+
+    results = {}
+    for family, records in data.items():
+        for r in records:
+            results.setdefault(f"{family} ({r['engine']})", []).append(r)
+    return results
+
+def plot_scalability(results, output='scalability_benchmark.png'):
     """Plot comprehensive scalability results"""
     fig = plt.figure(figsize=(16, 10))
 
@@ -320,8 +333,8 @@ def plot_scalability(results):
     ax3.legend(fontsize=10)
     ax3.grid(True, alpha=0.3)
 
-    plt.savefig('scalability_benchmark.png', dpi=150, bbox_inches='tight')
-    print(f"\n[SAVE] Saved comprehensive scalability plot: scalability_benchmark.png")
+    plt.savefig(output, dpi=150, bbox_inches='tight')
+    print(f"\n[SAVE] Saved comprehensive scalability plot: {output}")
     plt.show()
 
 def stress_test():
@@ -441,7 +454,11 @@ def main():
 
 if __name__ == "__main__":
     try:
-        main()
+        if len(sys.argv) == 3 and sys.argv[1] == '--cpp-benchmark':
+            # plot the output of the C++ benchmark instead of running NetworkX
+            plot_scalability(load_cpp_benchmark(sys.argv[2]), 'cpp_scalability_benchmark.png')
+        else:
+            main()
     except Exception as e:
         print(f"\nError: {e}")
         import traceback
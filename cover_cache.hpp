@@ -0,0 +1,211 @@
+#ifndef COVER_CACHE_HPP
+#define COVER_CACHE_HPP
+
+#include <list>
+#include <unordered_map>
+#include "graph.hpp"
+
+// A graph as the cache sees it: n, the number of edges, and two
+// independent 64-bit sums of a hash of every edge taken as (min, max).
+// Sums do not depend on the order of the edges or of their endpoints, so
+// the key is computed in one pass without sorting. An edge listed twice
+// counts twice.
+struct GraphKey {
+    int n = 0;
+    size_t edges = 0;
+    uint64_t first = 0, second = 0;
+
+    bool operator==(const GraphKey& other) const {
+        return n == other.n && edges == other.edges && first == other.first && second == other.second;
+    }
+
+    // splitmix64 finalizer
+    static uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    static GraphKey of(int n, const Edge* edges, size_t count, unsigned threads = 1) {
+        GraphKey key;
+        key.n = n;
+        key.edges = count;
+        std::atomic<uint64_t> first{0}, second{0};
+        parallelChunks(resolveThreads(threads), count, [&](unsigned, size_t begin, size_t end) {
+            uint64_t a = 0, b = 0;
+            for (size_t i = begin; i < end; i++) {
+                uint64_t lo = static_cast<uint32_t>(std::min(edges[i].u, edges[i].v));
+                uint64_t hi = static_cast<uint32_t>(std::max(edges[i].u, edges[i].v));
+                uint64_t h = mix(lo << 32 | hi);
+                a += h;
+                b += mix(h ^ 0x5851f42d4c957f2dULL);
+            }
+            first.fetch_add(a, std::memory_order_relaxed);
+            second.fetch_add(b, std::memory_order_relaxed);
+        }, 1 << 16);
+        key.first = first.load();
+        key.second = second.load();
+        return key;
+    }
+};
+
+struct GraphKeyHash {
+    size_t operator()(const GraphKey& key) const { return static_cast<size_t>(key.first); }
+};
+
+struct CacheOptions {
+    size_t byteBudget = 64 << 20;   // covers and mate arrays held, least recently used dropped first
+
+    // With a share above 0, every entry keeps its mate array, and a miss
+    // warm-starts from the most recently used entry with the same n whose
+    // edge count is within this share of the new one. The result is the
+    // same minimum cover either way. A seed pays off when most of its pairs
+    // are still edges of the new graph: each pair it loses costs one
+    // augmenting search, and on large non-bipartite graphs those searches
+    // are slow enough for a fresh solve to win
+    double warmStartShare = 0;
+};
+
+// what the last CoverCache::solve() did
+enum class CacheOutcome {
+    Hit,            // stored cover returned, nothing solved
+    WarmStart,      // solved from the mate array of a similar entry
+    Solved          // solved from scratch
+};
+
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t warmStarts = 0;        // misses seeded from another entry
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+// Minimum edge covers of graphs seen before. Entries are keyed by GraphKey
+// and kept in least recently used order within options.byteBudget. A hit
+// returns the stored cover and runs no matching at all. A miss solves with
+// a MinEdgeCover, warm-started (MinEdgeCover::warmStartFrom()) from the
+// mate array of an entry of a similar graph when there is one, so only the
+// vertices its pairs leave free are searched. Either way the cover and its
+// mates are stored for later calls; DynamicMinEdgeCover takes the same
+// mates as a seed.
+//
+// Keys are not checked against the edges they came from, so two graphs
+// with the same key share an entry; with 128 bits of hash that takes
+// input built to collide. Like MinEdgeCover, a cache is for one thread at
+// a time.
+class CoverCache {
+private:
+    struct Entry {
+        GraphKey key;
+        std::vector<Edge> cover;
+        std::vector<int> mates;     // empty without CacheOptions::warmStartShare
+
+        size_t bytes() const {
+            return sizeof(Entry) + cover.capacity() * sizeof(Edge) + mates.capacity() * sizeof(int);
+        }
+    };
+
+    CacheOptions options;
+    SolverOptions solverOptions;
+    MinEdgeCover solver;
+    std::list<Entry> entries;       // most recently used first
+    std::unordered_map<GraphKey, std::list<Entry>::iterator, GraphKeyHash> index;
+    CacheStats counters;
+    CacheOutcome last = CacheOutcome::Solved;
+
+    void evictTo(size_t budget) {
+        while (counters.bytes > budget && !entries.empty()) {
+            counters.bytes -= entries.back().bytes();
+            index.erase(entries.back().key);
+            entries.pop_back();
+            counters.evictions++;
+        }
+    }
+
+    void store(Entry entry) {
+        size_t bytes = entry.bytes();
+        if (bytes > options.byteBudget) return;
+        evictTo(options.byteBudget - bytes);
+        entries.push_front(std::move(entry));
+        index[entries.front().key] = entries.begin();
+        counters.bytes += bytes;
+    }
+
+public:
+    explicit CoverCache(CacheOptions options = {}, SolverOptions solverOptions = {})
+        : options(options), solverOptions(solverOptions), solver(solverOptions) {}
+
+    // The minimum edge cover of (vertices, edgeList), from the cache when
+    // it holds the graph. Throws what MinEdgeCover throws for bad input
+    std::vector<Edge> solve(int vertices, const std::vector<Edge>& edgeList) {
+        GraphKey key = GraphKey::of(vertices, edgeList.data(), edgeList.size(), solverOptions.threads);
+        auto found = index.find(key);
+        if (found != index.end()) {
+            entries.splice(entries.begin(), entries, found->second);
+            counters.hits++;
+            last = CacheOutcome::Hit;
+            return entries.front().cover;
+        }
+
+        counters.misses++;
+        Entry entry;
+        entry.key = key;
+        solver.assign(vertices, edgeList);
+        const std::vector<int>* seed = seedFor(vertices, edgeList.size());
+        if (seed != nullptr) {
+            solver.warmStartFrom(*seed);
+            counters.warmStarts++;
+            last = CacheOutcome::WarmStart;
+        } else {
+            last = CacheOutcome::Solved;
+        }
+        solver.solveInto(entry.cover);
+        if (options.warmStartShare > 0) entry.mates = solver.mates();
+        std::vector<Edge> cover = entry.cover;
+        store(std::move(entry));
+        return cover;
+    }
+
+    CacheOutcome lastOutcome() const { return last; }
+
+    // The mate array of the most recently used entry with vertices
+    // vertices and an edge count within CacheOptions::warmStartShare of
+    // edgeCount, or null. solve() seeds its misses with it
+    const std::vector<int>* seedFor(int vertices, size_t edgeCount) const {
+        if (!(options.warmStartShare > 0)) return nullptr;
+        double slack = options.warmStartShare * static_cast<double>(edgeCount);
+        for (const Entry& entry : entries) {
+            double apart = std::abs(static_cast<double>(entry.key.edges) - static_cast<double>(edgeCount));
+            if (entry.key.n == vertices && !entry.mates.empty() && apart <= slack) return &entry.mates;
+        }
+        return nullptr;
+    }
+
+    CacheStats stats() const {
+        CacheStats s = counters;
+        s.entries = entries.size();
+        return s;
+    }
+
+    bool contains(int vertices, const std::vector<Edge>& edgeList) const {
+        return index.count(GraphKey::of(vertices, edgeList.data(), edgeList.size(), solverOptions.threads)) != 0;
+    }
+
+    // drops every entry; the counters are kept
+    void clear() {
+        entries.clear();
+        index.clear();
+        counters.bytes = 0;
+    }
+
+    // a smaller budget evicts at once
+    void setByteBudget(size_t budget) {
+        options.byteBudget = budget;
+        evictTo(budget);
+    }
+};
+
+#endif // COVER_CACHE_HPP
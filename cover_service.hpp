@@ -0,0 +1,203 @@
+#ifndef COVER_SERVICE_HPP
+#define COVER_SERVICE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include "graph.hpp"
+
+// Called on the worker thread once a job is done, before its future is
+// made ready: with the result, or with an empty result and the exception
+// that ended the job. An exception thrown by the callback goes to the
+// future instead of the result
+using CoverCallback = std::function<void(const CoverResult&, std::exception_ptr)>;
+
+// one submitted graph, shared by the queue, its worker and its ticket
+struct CoverJob {
+    int n;
+    std::vector<Edge> edges;
+    StopSignal stop;
+    std::promise<CoverResult> promise;
+    CoverCallback callback;
+
+    CoverJob(int n, std::vector<Edge> edges, std::chrono::steady_clock::time_point deadline, CoverCallback callback)
+        : n(n), edges(std::move(edges)), stop(deadline), callback(std::move(callback)) {}
+};
+
+// The caller's handle on a submitted job
+class CoverTicket {
+private:
+    std::shared_ptr<CoverJob> job;
+    std::future<CoverResult> future;
+
+public:
+    CoverTicket() = default;
+    explicit CoverTicket(std::shared_ptr<CoverJob> job) : job(job), future(job->promise.get_future()) {}
+
+    // A queued job is dropped, and get() throws std::runtime_error. A
+    // running one stops augmenting and delivers the cover it has, with
+    // CoverResult::stopped set. Safe from any thread, any number of times
+    void cancel() {
+        if (job) job->stop.cancel();
+    }
+
+    bool valid() const { return future.valid(); }
+
+    bool ready() const {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    void wait() const { future.wait(); }
+
+    template <typename Rep, typename Period>
+    bool waitFor(const std::chrono::duration<Rep, Period>& timeout) const {
+        return future.wait_for(timeout) == std::future_status::ready;
+    }
+
+    // the result, once; rethrows what ended the job
+    CoverResult get() { return future.get(); }
+};
+
+// Minimum edge covers computed in the background. Jobs wait in a FIFO
+// queue for options.threads workers, each of which solves one job at a
+// time with its own MinEdgeCover, assign()ed every graph, so a worker
+// stops allocating once it has seen its largest graph. A job's result
+// reaches the caller through its CoverTicket, its optional callback, or
+// both.
+//
+// A job may have a timeout, counted from submission so the time spent in
+// the queue counts too. When it runs out, or the ticket is cancelled, the
+// engines stop at their next poll of the job's StopSignal and the job
+// still delivers an edge cover: the matching found so far, completed as
+// usual, with CoverResult::gapBound saying how far from minimum it may be.
+// The warm start always runs to the end, so the latency of a job that
+// times out is about its queueing time plus one linear pass.
+class CoverService {
+private:
+    SolverOptions options;
+    mutable std::mutex lock;
+    std::condition_variable wake;
+    std::deque<std::shared_ptr<CoverJob>> queue;
+    std::vector<std::shared_ptr<CoverJob>> running;     // per worker, null when idle
+    bool closing = false;
+    std::vector<std::thread> workers;
+
+    static void run(MinEdgeCover& solver, CoverJob& job) {
+        CoverResult result;
+        std::exception_ptr error;
+        try {
+            if (job.stop.isCancelled()) {
+                throw std::runtime_error("Job was cancelled before it started");
+            }
+            solver.setStopSignal(&job.stop);
+            solver.assign(job.n, job.edges);
+            result = solver.solveDetailed();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        solver.setStopSignal(nullptr);
+        std::vector<Edge>().swap(job.edges);
+
+        if (job.callback) {
+            try {
+                job.callback(result, error);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        if (error) {
+            job.promise.set_exception(error);
+        } else {
+            job.promise.set_value(std::move(result));
+        }
+    }
+
+    void work(unsigned w) {
+        SolverOptions perJob = options;
+        perJob.threads = 1;
+        perJob.stop = nullptr;
+        MinEdgeCover solver(perJob);
+        for (;;) {
+            std::shared_ptr<CoverJob> job;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&] { return closing || !queue.empty(); });
+                if (queue.empty()) return;
+                job = std::move(queue.front());
+                queue.pop_front();
+                running[w] = job;
+            }
+            run(solver, *job);
+            std::lock_guard<std::mutex> guard(lock);
+            running[w].reset();
+        }
+    }
+
+public:
+    explicit CoverService(SolverOptions options = {}) : options(options) {
+        unsigned count = resolveThreads(options.threads);
+        running.resize(count);
+        workers.reserve(count);
+        for (unsigned w = 0; w < count; w++) {
+            workers.emplace_back(&CoverService::work, this, w);
+        }
+    }
+
+    CoverService(const CoverService&) = delete;
+    CoverService& operator=(const CoverService&) = delete;
+
+    // waits for every queued job to finish; cancelAll() first to make that
+    // quick
+    ~CoverService() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closing = true;
+        }
+        wake.notify_all();
+        for (auto& t : workers) {
+            t.join();
+        }
+    }
+
+    // Queues the cover of the graph (vertices, edges), which the job takes
+    // over. A zero timeout never expires. Input errors reach the ticket as
+    // the exceptions MinEdgeCover throws for them
+    CoverTicket submit(int vertices, std::vector<Edge> edges,
+                       std::chrono::nanoseconds timeout = std::chrono::nanoseconds::zero(),
+                       CoverCallback callback = nullptr) {
+        auto deadline = timeout > std::chrono::nanoseconds::zero() ? std::chrono::steady_clock::now() + timeout
+                                                                   : std::chrono::steady_clock::time_point::max();
+        auto job = std::make_shared<CoverJob>(vertices, std::move(edges), deadline, std::move(callback));
+        CoverTicket ticket(job);
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (closing) {
+                throw std::logic_error("Cover service is shutting down");
+            }
+            queue.push_back(std::move(job));
+        }
+        wake.notify_one();
+        return ticket;
+    }
+
+    // cancels every job queued or running at the time of the call
+    void cancelAll() {
+        std::lock_guard<std::mutex> guard(lock);
+        for (auto& job : queue) job->stop.cancel();
+        for (auto& job : running) {
+            if (job) job->stop.cancel();
+        }
+    }
+
+    // jobs waiting for a worker
+    size_t queued() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return queue.size();
+    }
+
+    unsigned workerCount() const { return static_cast<unsigned>(workers.size()); }
+};
+
+#endif // COVER_SERVICE_HPP
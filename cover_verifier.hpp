@@ -0,0 +1,209 @@
+#ifndef COVER_VERIFIER_HPP
+#define COVER_VERIFIER_HPP
+
+#include "graph.hpp"
+
+// outcome of CoverVerifier::verify()
+struct VerifyReport {
+    bool valid = false;             // an edge cover made of edges of the graph
+    bool optimal = false;           // and minimum, as the certificate proves
+    int uncoveredVertex = -1;       // first vertex no cover edge touches
+    size_t foreignEdge = SIZE_MAX;  // first cover edge that is not in the graph
+    int invalidMate = -1;           // first vertex whose certificate mate is wrong
+
+    int matchingSize = 0;           // |M| of the certificate
+    int matchingBound = 0;          // Tutte-Berge bound of its barrier
+    std::chrono::nanoseconds time{0};
+};
+
+// Independent check of a solver result against the graph it came from.
+// Every pass is parallel over parallelChunks() workers:
+//  - coverage: each cover edge sets its endpoints in an atomic bitset
+//  - membership: each cover edge is looked up in the shorter of its two
+//    CSR rows. A minimum cover is a union of stars, so this is O(V + E)
+//  - optimality: the certificate mates must form a matching of the graph
+//    with |M| = n - |cover|. Its barrier S must meet the Tutte-Berge
+//    bound, with the odd components of G - S counted by a lock-free
+//    union-find over the edges
+// None of this reuses solver state, so a bug in an engine cannot hide
+// itself.
+class CoverVerifier {
+private:
+    static void lowerTo(std::atomic<size_t>& first, size_t value) {
+        size_t seen = first.load(std::memory_order_relaxed);
+        while (value < seen && !first.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+    }
+
+    template <typename Graph>
+    static bool hasEdge(const Graph& g, uint32_t a, uint32_t b) {
+        if (g.degree(b) < g.degree(a)) std::swap(a, b);
+        for (uint32_t w : g[a]) {
+            if (w == b) return true;
+        }
+        return false;
+    }
+
+    static int find(std::atomic<int>* parent, int x) {
+        for (;;) {
+            int p = parent[x].load(std::memory_order_relaxed);
+            if (p == x) return x;
+            int grand = parent[p].load(std::memory_order_relaxed);
+            if (p != grand) parent[x].compare_exchange_weak(p, grand, std::memory_order_relaxed);
+            x = grand;
+        }
+    }
+
+    // links the larger root under the smaller, so no cycle can form
+    static void unite(std::atomic<int>* parent, int a, int b) {
+        for (;;) {
+            a = find(parent, a);
+            b = find(parent, b);
+            if (a == b) return;
+            if (a < b) std::swap(a, b);
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return;
+        }
+    }
+
+    // components of odd size in the graph without the marked vertices
+    template <typename Graph>
+    static int oddComponents(const Graph& g, const std::vector<uint8_t>& removed, unsigned threads) {
+        int n = static_cast<int>(g.n);
+        std::unique_ptr<std::atomic<int>[]> parent(new std::atomic<int>[n]);
+        std::unique_ptr<std::atomic<int>[]> size(new std::atomic<int>[n]);
+        parallelChunks(threads, n, [&](unsigned, size_t begin, size_t end) {
+            for (size_t v = begin; v < end; v++) {
+                parent[v].store(static_cast<int>(v), std::memory_order_relaxed);
+                size[v].store(0, std::memory_order_relaxed);
+            }
+        });
+        parallelChunks(threads, n, [&](unsigned, size_t begin, size_t end) {
+            for (size_t v = begin; v < end; v++) {
+                if (removed[v]) continue;
+                for (uint32_t w : g[static_cast<uint32_t>(v)]) {
+                    if (w > v && !removed[w]) unite(parent.get(), static_cast<int>(v), static_cast<int>(w));
+                }
+            }
+        });
+        parallelChunks(threads, n, [&](unsigned, size_t begin, size_t end) {
+            for (size_t v = begin; v < end; v++) {
+                if (!removed[v]) size[find(parent.get(), static_cast<int>(v))].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        std::atomic<int> odd{0};
+        parallelChunks(threads, n, [&](unsigned, size_t begin, size_t end) {
+            int local = 0;
+            for (size_t v = begin; v < end; v++) {
+                local += size[v].load(std::memory_order_relaxed) % 2;
+            }
+            odd.fetch_add(local, std::memory_order_relaxed);
+        });
+        return odd.load();
+    }
+
+    // checks the certificate and fills the matching fields of report;
+    // true when it proves a maximum matching
+    template <typename Graph>
+    static bool checkCertificate(const Graph& g, const MatchingCertificate& proof, unsigned threads,
+                               VerifyReport& report) {
+        int n = static_cast<int>(g.n);
+        if (proof.mates.size() != g.n) {
+            report.invalidMate = 0;
+            return false;
+        }
+        std::atomic<size_t> badMate{SIZE_MAX};
+        std::atomic<int> matched{0};
+        parallelChunks(threads, n, [&](unsigned, size_t begin, size_t end) {
+            int local = 0;
+            for (size_t v = begin; v < end; v++) {
+                int m = proof.mates[v];
+                if (m == -1) continue;
+                if (m < 0 || m >= n || m == static_cast<int>(v) || proof.mates[m] != static_cast<int>(v) ||
+                    !hasEdge(g, static_cast<uint32_t>(v), static_cast<uint32_t>(m))) {
+                    lowerTo(badMate, v);
+                } else {
+                    local++;
+                }
+            }
+            matched.fetch_add(local, std::memory_order_relaxed);
+        });
+        if (badMate.load() != SIZE_MAX) {
+            report.invalidMate = static_cast<int>(badMate.load());
+            return false;
+        }
+        report.matchingSize = matched.load() / 2;
+        if (report.matchingSize == n / 2) {
+            // no matching is larger, whatever the barrier
+            report.matchingBound = n / 2;
+            return true;
+        }
+
+        std::vector<uint8_t> removed(n, 0);
+        int barrier = 0;
+        for (int v : proof.barrier) {
+            if (v < 0 || v >= n) return false;
+            if (!removed[v]) barrier++;
+            removed[v] = 1;
+        }
+        report.matchingBound = (n + barrier - oddComponents(g, removed, threads)) / 2;
+        return report.matchingSize == report.matchingBound;
+    }
+
+public:
+    // Checks that cover is an edge cover of g made of g's edges. With a
+    // certificate, as given by MinEdgeCover::certificate(), it also checks
+    // that the cover is minimum. g may be a view or a graph of any width
+    template <typename Graph>
+    static VerifyReport verify(const Graph& g, const std::vector<Edge>& cover,
+                               const MatchingCertificate* certificate = nullptr, unsigned threads = 1) {
+        auto start = std::chrono::steady_clock::now();
+        VerifyReport report;
+        threads = resolveThreads(threads);
+        size_t n = g.n;
+        size_t words = (n + 63) / 64;
+        std::unique_ptr<std::atomic<uint64_t>[]> covered(new std::atomic<uint64_t>[words]);
+        parallelChunks(threads, words, [&](unsigned, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                covered[i].store(0, std::memory_order_relaxed);
+            }
+        });
+
+        std::atomic<size_t> foreign{SIZE_MAX};
+        parallelChunks(threads, cover.size(), [&](unsigned, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const Edge& e = cover[i];
+                if (e.u < 0 || static_cast<size_t>(e.u) >= n || e.v < 0 || static_cast<size_t>(e.v) >= n ||
+                    !hasEdge(g, static_cast<uint32_t>(e.u), static_cast<uint32_t>(e.v))) {
+                    lowerTo(foreign, i);
+                    continue;
+                }
+                covered[e.u / 64].fetch_or(uint64_t(1) << (e.u % 64), std::memory_order_relaxed);
+                covered[e.v / 64].fetch_or(uint64_t(1) << (e.v % 64), std::memory_order_relaxed);
+            }
+        });
+        report.foreignEdge = foreign.load();
+
+        std::atomic<size_t> uncovered{SIZE_MAX};
+        parallelChunks(threads, words, [&](unsigned, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                uint64_t full = i + 1 < words || n % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (n % 64)) - 1;
+                uint64_t missing = ~covered[i].load(std::memory_order_relaxed) & full;
+                if (missing != 0) {
+                    int bit = 0;
+                    while (!((missing >> bit) & 1)) bit++;
+                    lowerTo(uncovered, i * 64 + bit);
+                }
+            }
+        });
+        if (uncovered.load() != SIZE_MAX) report.uncoveredVertex = static_cast<int>(uncovered.load());
+
+        report.valid = report.foreignEdge == SIZE_MAX && report.uncoveredVertex == -1;
+        if (certificate != nullptr && checkCertificate(g, *certificate, threads, report)) {
+            report.optimal = report.valid && cover.size() == n - static_cast<size_t>(report.matchingSize);
+        }
+        report.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        return report;
+    }
+};
+
+#endif // COVER_VERIFIER_HPP
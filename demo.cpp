@@ -1,7 +1,7 @@
 #include <iostream>
-#include <fstream>
 #include <iomanip>
 #include "graph.hpp"
+#include "graph_io.hpp"
 
 void printEdges(const std::vector<Edge>& edges) {
     std::cout << "Edges: ";
@@ -14,25 +14,13 @@ void printEdges(const std::vector<Edge>& edges) {
 
 void saveToFile(const std::string& filename, int n, const std::vector<Edge>& allEdges,
                 const std::vector<Edge>& cover) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open file for writing: " << filename << std::endl;
+    // text format read by visualize.py; graph_convert turns it into binary
+    try {
+        writeTextGraph(filename, n, allEdges, cover);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
         return;
     }
-
-    file << n << " " << allEdges.size() << " " << cover.size() << std::endl;
-
-    // All graph edges
-    for (const auto& e : allEdges) {
-        file << e.u << " " << e.v << std::endl;
-    }
-
-    // Cover edges (for highlighting)
-    for (const auto& e : cover) {
-        file << e.u << " " << e.v << std::endl;
-    }
-
-    file.close();
     std::cout << "Data saved to file: " << filename << std::endl;
 }
 
@@ -49,9 +37,11 @@ void example1() {
     printEdges(edges);
 
     MinEdgeCover mec(n, edges);
-    std::vector<Edge> cover = mec.solve();
+    CoverResult result = mec.solveDetailed();
+    const std::vector<Edge>& cover = result.edges;
 
     std::cout << "\nMinimum Edge Cover:" << std::endl;
+    std::cout << "Matching engine: " << engineName(result.engine) << std::endl;
     std::cout << "Number of edges in cover: " << cover.size() << std::endl;
     printEdges(cover);
 
@@ -73,9 +63,11 @@ void example2() {
     printEdges(edges);
 
     MinEdgeCover mec(n, edges);
-    std::vector<Edge> cover = mec.solve();
+    CoverResult result = mec.solveDetailed();
+    const std::vector<Edge>& cover = result.edges;
 
     std::cout << "\nMinimum Edge Cover:" << std::endl;
+    std::cout << "Matching engine: " << engineName(result.engine) << std::endl;
     std::cout << "Number of edges in cover: " << cover.size() << std::endl;
     printEdges(cover);
 
@@ -97,9 +89,11 @@ void example3() {
     printEdges(edges);
 
     MinEdgeCover mec(n, edges);
-    std::vector<Edge> cover = mec.solve();
+    CoverResult result = mec.solveDetailed();
+    const std::vector<Edge>& cover = result.edges;
 
     std::cout << "\nMinimum Edge Cover:" << std::endl;
+    std::cout << "Matching engine: " << engineName(result.engine) << std::endl;
     std::cout << "Number of edges in cover: " << cover.size() << std::endl;
     printEdges(cover);
 
@@ -108,6 +102,36 @@ void example3() {
     saveToFile("graph3.txt", n, edges, cover);
 }
 
+void example4() {
+    std::cout << "\n=== Example 4: Greedy Engine ===" << std::endl;
+
+    // a 4-cycle with a pendant vertex on 1 and on 2: the greedy pass
+    // matches (0, 1) and (2, 3) and leaves 4 and 5 exposed; the BFS
+    // improvement then flips the path 4-1-0-3-2-5
+    int n = 6;
+    std::vector<Edge> edges = {
+        {0, 1}, {1, 2}, {2, 3}, {3, 0}, {1, 4}, {2, 5}
+    };
+
+    std::cout << "Number of vertices: " << n << std::endl;
+    std::cout << "Number of edges: " << edges.size() << std::endl;
+    printEdges(edges);
+
+    SolverOptions options;
+    options.engine = MatchingEngine::Greedy;
+    MinEdgeCover mec(n, edges, options);
+    CoverResult result = mec.solveDetailed();
+    const std::vector<Edge>& cover = result.edges;
+
+    std::cout << "\nEdge Cover:" << std::endl;
+    std::cout << "Matching engine: " << engineName(result.engine) << std::endl;
+    std::cout << "Augmentations: " << result.augmentations << std::endl;
+    std::cout << "Number of edges in cover: " << cover.size() << std::endl;
+    printEdges(cover);
+
+    std::cout << "Verification: " << (MinEdgeCover::isEdgeCover(n, cover) ? "CORRECT" : "ERROR") << std::endl;
+}
+
 void customInput() {
     std::cout << "\n=== Custom Input ===" << std::endl;
 
@@ -127,9 +151,11 @@ void customInput() {
 
     try {
         MinEdgeCover mec(n, edges);
-        std::vector<Edge> cover = mec.solve();
+        CoverResult result = mec.solveDetailed();
+        const std::vector<Edge>& cover = result.edges;
 
         std::cout << "\nMinimum Edge Cover:" << std::endl;
+        std::cout << "Matching engine: " << engineName(result.engine) << std::endl;
         std::cout << "Number of edges in cover: " << cover.size() << std::endl;
         printEdges(cover);
 
@@ -149,6 +175,7 @@ int main() {
     example1();
     example2();
     example3();
+    example4();
 
     std::cout << "\n" << std::string(54, '=') << std::endl;
     std::cout << "Would you like to enter your own graph? (y/n): ";
@@ -0,0 +1,260 @@
+#ifndef DYNAMIC_EDGE_COVER_HPP
+#define DYNAMIC_EDGE_COVER_HPP
+
+#include "graph.hpp"
+
+// Minimum edge cover maintained under edge insertions and deletions.
+//
+// The solver keeps a maximum matching (as a mate array) and, for every
+// exposed vertex, the one incident edge that covers it. An update touches
+// only the alternating trees grown from the endpoints it affects:
+//  - insert: exposed endpoints get matched directly or search for one
+//    augmenting path; for an edge between two matched vertices one endpoint
+//    is freed by moving its exposure along an alternating path, then the
+//    search starts from it
+//  - delete: a removed matched edge re-augments from its exposed endpoints
+// Deleting can never grow the matching and inserting grows it by at most
+// one, so these local repairs keep it maximum.
+class DynamicMinEdgeCover {
+private:
+    int n;
+    std::vector<std::vector<int>> adj;
+    std::vector<int> match;
+    std::vector<int> coverPartner;  // exposed vertex -> neighbour covering it, -1 if isolated
+    BlossomMatcher<std::vector<std::vector<int>>> matcher;
+    int matched = 0;                // vertices covered by the matching
+    int isolated;
+    bool exact = true;              // false once a budgeted search gave up
+
+    void checkVertex(int v) const {
+        if (v < 0 || v >= n) {
+            throw std::invalid_argument("Invalid vertex index");
+        }
+    }
+
+    bool hasEdge(int u, int v) const {
+        const std::vector<int>& row = adj[u].size() <= adj[v].size() ? adj[u] : adj[v];
+        int other = adj[u].size() <= adj[v].size() ? v : u;
+        return std::find(row.begin(), row.end(), other) != row.end();
+    }
+
+    void removeOne(std::vector<int>& row, int v) {
+        auto it = std::find(row.begin(), row.end(), v);
+        *it = row.back();
+        row.pop_back();
+    }
+
+    // picks the cover edge of an exposed vertex from its own row
+    void pickCoverEdge(int v) {
+        coverPartner[v] = adj[v].empty() ? -1 : adj[v][0];
+    }
+
+    void setMatched(int u, int v) {
+        match[u] = v;
+        match[v] = u;
+    }
+
+    // unmatches v (the caller exposes its partner too)
+    void expose(int v) {
+        match[v] = -1;
+        matched--;
+        pickCoverEdge(v);
+    }
+
+    // augments from an exposed root; both endpoints of the path become matched
+    bool tryAugment(int root, int firstHop = -1) {
+        int end = matcher.augmentFrom(root, firstHop);
+        if (end == -1) {
+            if (matcher.lastSearchTruncated()) exact = false;
+            return false;
+        }
+        matched += 2;
+        coverPartner[root] = coverPartner[end] = -1;
+        return true;
+    }
+
+    void addEdges(const std::vector<Edge>& edgeList) {
+        for (const auto& e : edgeList) {
+            checkVertex(e.u);
+            checkVertex(e.v);
+            if (adj[e.u].empty()) isolated--;
+            adj[e.u].push_back(e.v);
+            if (e.u != e.v) {
+                if (adj[e.v].empty()) isolated--;
+                adj[e.v].push_back(e.u);
+            }
+        }
+    }
+
+    void matchGreedily(const std::vector<Edge>& edgeList) {
+        for (const auto& e : edgeList) {
+            if (e.u != e.v && match[e.u] == -1 && match[e.v] == -1) {
+                setMatched(e.u, e.v);
+            }
+        }
+    }
+
+    // full sweep from every exposed vertex, ignoring the search budget
+    void sweep() {
+        matcher.run();
+        matched = 0;
+        for (int v = 0; v < n; v++) {
+            if (match[v] != -1) {
+                matched++;
+                coverPartner[v] = -1;
+            } else {
+                pickCoverEdge(v);
+            }
+        }
+        exact = true;
+    }
+
+    // new edge (u, v) between two matched vertices. Any augmenting path has
+    // to use it, so u must first be shown to be missed by some maximum
+    // matching: free u and re-augment from its partner without u. If that
+    // works, every augmenting path of G + (u, v) now starts at the exposed u
+    void repairThroughEdge(int u, int v) {
+        int pu = match[u];
+        match[u] = match[pu] = -1;
+        matched -= 2;
+
+        matcher.exclude(u);
+        bool moved = tryAugment(pu);
+        matcher.clearExclusions();
+        if (!moved) {
+            // u is covered by every maximum matching: nothing can change
+            setMatched(u, pu);
+            matched += 2;
+            return;
+        }
+        if (!tryAugment(u, v)) pickCoverEdge(u);
+    }
+
+public:
+    explicit DynamicMinEdgeCover(int vertices)
+        : n(vertices), adj(vertices > 0 ? vertices : 0), match(adj.size(), -1),
+          coverPartner(adj.size(), -1), matcher(adj, static_cast<int>(adj.size()), match),
+          isolated(vertices) {
+        if (vertices <= 0) {
+            throw std::invalid_argument("Number of vertices must be positive");
+        }
+    }
+
+    DynamicMinEdgeCover(int vertices, const std::vector<Edge>& edgeList)
+        : DynamicMinEdgeCover(vertices) {
+        addEdges(edgeList);
+        // greedy start, then one static sweep
+        matchGreedily(edgeList);
+        sweep();
+    }
+
+    // Starts from seed, the mate array of the same or a similar graph (an
+    // earlier snapshot, a cached solve). Its pairs that are edges here are
+    // kept and the others dropped, the free vertices are matched greedily,
+    // and one sweep makes the matching maximum. Near a maximum seed, the
+    // sweep is left with failing searches, each tree searched once
+    DynamicMinEdgeCover(int vertices, const std::vector<Edge>& edgeList, const std::vector<int>& seed)
+        : DynamicMinEdgeCover(vertices) {
+        if (seed.size() != adj.size()) {
+            throw std::invalid_argument("Seed matching does not have one mate per vertex");
+        }
+        addEdges(edgeList);
+        for (int v = 0; v < n; v++) {
+            int m = seed[v];
+            if (v < m && m < n && seed[m] == v && hasEdge(v, m)) setMatched(v, m);
+        }
+        matchGreedily(edgeList);
+        sweep();
+    }
+
+    void insertEdge(int u, int v) {
+        checkVertex(u);
+        checkVertex(v);
+        if (adj[u].empty()) isolated--;
+        adj[u].push_back(v);
+        if (u == v) {
+            // a self-loop can only cover its vertex
+            if (match[u] == -1) coverPartner[u] = u;
+            return;
+        }
+        if (adj[v].empty()) isolated--;
+        adj[v].push_back(u);
+
+        if (match[u] == -1 && match[v] == -1) {
+            setMatched(u, v);
+            matched += 2;
+            coverPartner[u] = coverPartner[v] = -1;
+        } else if (match[u] == -1) {
+            // the matching was maximum, so a new path must start with (u, v)
+            if (!tryAugment(u, v) && coverPartner[u] == -1) coverPartner[u] = v;
+        } else if (match[v] == -1) {
+            if (!tryAugment(v, u) && coverPartner[v] == -1) coverPartner[v] = u;
+        } else if (match[u] != v) {
+            repairThroughEdge(u, v);
+        }
+    }
+
+    // removes one copy of (u, v); returns false if the edge is not present
+    bool deleteEdge(int u, int v) {
+        checkVertex(u);
+        checkVertex(v);
+        if (!hasEdge(u, v)) return false;
+
+        removeOne(adj[u], v);
+        if (adj[u].empty()) isolated++;
+        if (u != v) {
+            removeOne(adj[v], u);
+            if (adj[v].empty()) isolated++;
+        }
+
+        if (u != v && match[u] == v && !hasEdge(u, v)) {
+            expose(u);
+            expose(v);
+            // the matching shrinks by at most one: one endpoint must re-augment
+            if (!tryAugment(u)) tryAugment(v);
+            return true;
+        }
+
+        // a removed cover edge of an exposed vertex is replaced from its row
+        if (match[u] == -1 && coverPartner[u] == v) pickCoverEdge(u);
+        if (match[v] == -1 && coverPartner[v] == u) pickCoverEdge(v);
+        return true;
+    }
+
+    // Caps the vertices one repair search may label, bounding update latency
+    // on graphs with huge alternating trees. A search that hits the cap is
+    // treated as failed, so the matching may fall short of maximum until
+    // resolve() is called; isExact() tells whether that has happened.
+    void setSearchBudget(size_t maxVertices) { matcher.setSearchLimit(maxVertices); }
+    bool isExact() const { return exact; }
+
+    // restores a maximum matching with one full sweep
+    void resolve() { sweep(); }
+
+    // false while some vertex has no incident edge
+    bool isCoverable() const { return isolated == 0; }
+
+    int vertexCount() const { return n; }
+    int matchingSize() const { return matched / 2; }
+    int coverSize() const { return matched / 2 + (n - matched); }
+    const std::vector<int>& mates() const { return match; }
+
+    // materializes the current cover in O(V)
+    std::vector<Edge> cover() const {
+        if (!isCoverable()) {
+            throw std::invalid_argument("Graph contains isolated vertices - edge cover impossible");
+        }
+        std::vector<Edge> result;
+        result.reserve(coverSize());
+        for (int v = 0; v < n; v++) {
+            if (match[v] == -1) {
+                result.push_back(Edge(v, coverPartner[v]));
+            } else if (v < match[v]) {
+                result.push_back(Edge(v, match[v]));
+            }
+        }
+        return result;
+    }
+};
+
+#endif // DYNAMIC_EDGE_COVER_HPP
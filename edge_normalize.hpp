@@ -0,0 +1,178 @@
+#ifndef EDGE_NORMALIZE_HPP
+#define EDGE_NORMALIZE_HPP
+
+#include "graph.hpp"
+
+// what normalizeEdges() does with an edge from a vertex to itself
+enum class SelfLoopPolicy {
+    Keep,       // one copy, like any other edge
+    Drop,
+    Reject      // std::invalid_argument
+};
+
+struct NormalizeOptions {
+    SelfLoopPolicy selfLoops = SelfLoopPolicy::Keep;
+    unsigned threads = 1;   // sort and compaction threads, 0 = one per hardware thread
+};
+
+// Every distinct edge of an input list once, as (min, max) and sorted by
+// that pair, with the input index of its first copy
+struct NormalizedEdges {
+    std::vector<Edge> edges;
+    std::vector<uint32_t> inputIds;
+    size_t duplicates = 0;      // copies removed, reversed ones included
+    size_t selfLoops = 0;       // self-loops removed by SelfLoopPolicy::Drop
+
+    // the CSR of the normalized edges, with the input indices as its edge
+    // ids, so MinEdgeCover::coverEdgeIds() names edges of the input list
+    CSRGraph toCSR(uint32_t n) const {
+        CSRGraph g;
+        g.assign(n, edges.data(), edges.size(), true);
+        for (uint32_t& id : g.edgeIds) {
+            id = inputIds[id];
+        }
+        return g;
+    }
+};
+
+// Stable LSD radix sort of keys on 11-bit digits, carrying ids along; only
+// the low bits are sorted. The input is cut into fixed blocks, each with
+// its own histogram per digit, so parallelChunks() workers count and
+// scatter whole blocks without ever waiting on each other.
+struct RadixSort {
+    static constexpr unsigned digitBits = 11;
+    static constexpr size_t radix = size_t(1) << digitBits;
+    static constexpr size_t block = size_t(1) << 16;
+
+    static void sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& ids, unsigned bits, unsigned threads) {
+        size_t count = keys.size();
+        size_t blocks = (count + block - 1) / block;
+        std::vector<uint64_t> keyBuffer(count);
+        std::vector<uint32_t> idBuffer(count);
+        std::vector<size_t> offsets(blocks * radix);
+
+        for (unsigned shift = 0; shift < bits; shift += digitBits) {
+            parallelChunks(threads, blocks, [&](unsigned, size_t first, size_t last) {
+                for (size_t b = first; b < last; b++) {
+                    size_t* histogram = &offsets[b * radix];
+                    std::fill(histogram, histogram + radix, 0);
+                    for (size_t i = b * block, end = std::min(count, i + block); i < end; i++) {
+                        histogram[(keys[i] >> shift) & (radix - 1)]++;
+                    }
+                }
+            }, 1);
+
+            // digit-major, block-minor prefix sum: where each block starts
+            // writing each digit
+            size_t sum = 0;
+            for (size_t d = 0; d < radix; d++) {
+                for (size_t b = 0; b < blocks; b++) {
+                    size_t c = offsets[b * radix + d];
+                    offsets[b * radix + d] = sum;
+                    sum += c;
+                }
+            }
+
+            parallelChunks(threads, blocks, [&](unsigned, size_t first, size_t last) {
+                for (size_t b = first; b < last; b++) {
+                    size_t* next = &offsets[b * radix];
+                    for (size_t i = b * block, end = std::min(count, i + block); i < end; i++) {
+                        size_t at = next[(keys[i] >> shift) & (radix - 1)]++;
+                        keyBuffer[at] = keys[i];
+                        idBuffer[at] = ids[i];
+                    }
+                }
+            }, 1);
+            keys.swap(keyBuffer);
+            ids.swap(idBuffer);
+        }
+    }
+};
+
+// Sorts the edges by (min(u, v), max(u, v)) with a parallel radix sort over
+// the key min * n + max, keeps the first copy of every edge and applies the
+// self-loop policy. The sort is stable, so the id kept for an edge is the
+// smallest input index it appears under.
+inline NormalizedEdges normalizeEdges(uint32_t n, const Edge* edges, size_t count, NormalizeOptions options = {}) {
+    if (count > UINT32_MAX) {
+        throw std::length_error("Too many edges for 32-bit edge ids");
+    }
+    unsigned threads = resolveThreads(options.threads);
+    std::vector<uint64_t> keys(count);
+    std::vector<uint32_t> ids(count);
+    std::atomic<bool> invalid{false}, selfLoop{false};
+    parallelChunks(threads, count, [&](unsigned, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const Edge& e = edges[i];
+            if (e.u < 0 || static_cast<uint32_t>(e.u) >= n || e.v < 0 || static_cast<uint32_t>(e.v) >= n) {
+                invalid.store(true, std::memory_order_relaxed);
+                continue;
+            }
+            if (e.u == e.v) selfLoop.store(true, std::memory_order_relaxed);
+            uint64_t a = static_cast<uint32_t>(std::min(e.u, e.v)), b = static_cast<uint32_t>(std::max(e.u, e.v));
+            keys[i] = a * n + b;
+            ids[i] = static_cast<uint32_t>(i);
+        }
+    });
+    if (invalid.load()) {
+        throw std::invalid_argument("Invalid vertex index");
+    }
+    if (selfLoop.load() && options.selfLoops == SelfLoopPolicy::Reject) {
+        throw std::invalid_argument("Graph contains a self-loop");
+    }
+
+    unsigned bits = 0;   // of the largest key, n^2 - 1
+    for (uint64_t top = static_cast<uint64_t>(n) * n - 1; top > 0; top >>= 1) bits++;
+    RadixSort::sort(keys, ids, bits, threads);
+
+    // compaction in the same blocks: count what each block keeps, then
+    // write it at the block's offset
+    bool dropLoops = options.selfLoops == SelfLoopPolicy::Drop;
+    auto isLoop = [n](uint64_t key) { return key / n == key % n; };
+    auto kept = [&](size_t i) {
+        return (i == 0 || keys[i] != keys[i - 1]) && !(dropLoops && isLoop(keys[i]));
+    };
+    size_t blocks = (count + RadixSort::block - 1) / RadixSort::block;
+    std::vector<size_t> starts(blocks + 1, 0);
+    parallelChunks(threads, blocks, [&](unsigned, size_t first, size_t last) {
+        for (size_t b = first; b < last; b++) {
+            size_t c = 0;
+            for (size_t i = b * RadixSort::block, end = std::min(count, i + RadixSort::block); i < end; i++) {
+                c += kept(i);
+            }
+            starts[b + 1] = c;
+        }
+    }, 1);
+    for (size_t b = 0; b < blocks; b++) {
+        starts[b + 1] += starts[b];
+    }
+
+    NormalizedEdges result;
+    result.edges.resize(starts[blocks]);
+    result.inputIds.resize(starts[blocks]);
+    std::atomic<size_t> loops{0};
+    parallelChunks(threads, blocks, [&](unsigned, size_t first, size_t last) {
+        size_t dropped = 0;
+        for (size_t b = first; b < last; b++) {
+            size_t at = starts[b];
+            for (size_t i = b * RadixSort::block, end = std::min(count, i + RadixSort::block); i < end; i++) {
+                if (kept(i)) {
+                    result.edges[at] = Edge(static_cast<int>(keys[i] / n), static_cast<int>(keys[i] % n));
+                    result.inputIds[at++] = ids[i];
+                } else if (dropLoops && isLoop(keys[i])) {
+                    dropped++;
+                }
+            }
+        }
+        loops.fetch_add(dropped, std::memory_order_relaxed);
+    }, 1);
+    result.selfLoops = loops.load();
+    result.duplicates = count - result.edges.size() - result.selfLoops;
+    return result;
+}
+
+inline NormalizedEdges normalizeEdges(uint32_t n, const std::vector<Edge>& edges, NormalizeOptions options = {}) {
+    return normalizeEdges(n, edges.data(), edges.size(), options);
+}
+
+#endif // EDGE_NORMALIZE_HPP
@@ -4,7 +4,23 @@
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
-#include <queue>
+#include <deque>
+#include <memory_resource>
+#include <mutex>
+#include <cstdint>
+#include <climits>
+#include <utility>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <cmath>
+#include <limits>
+#include <string>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 struct Edge {
     int u, v;
@@ -15,151 +31,3195 @@ struct Edge {
     }
 };
 
-class MinEdgeCover {
+// Read-only CSR adjacency over arrays owned elsewhere: a BasicCSRGraph, or
+// a memory-mapped graph file (graph_io.hpp). Layout as in BasicCSRGraph
+// below; Index is the vertex id type, Offset the neighbour slot type.
+template <typename Index, typename Offset>
+struct BasicCSRView {
+    static_assert(std::is_unsigned<Index>::value && std::is_unsigned<Offset>::value,
+                  "CSR indices must be unsigned");
+    static_assert(sizeof(Index) <= sizeof(Offset), "CSR offsets must be at least as wide as the vertex ids");
+
+    uint32_t n = 0;
+    const Offset* offsets = nullptr;        // n + 1 entries
+    const Index* neighbors = nullptr;       // offsets[n] entries
+    const Offset* edgeIds = nullptr;        // null when absent
+
+    struct Neighbors {
+        const Index* first;
+        const Index* last;
+
+        const Index* begin() const { return first; }
+        const Index* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+        uint32_t operator[](size_t i) const { return first[i]; }
+    };
+
+    Neighbors operator[](uint32_t u) const {
+        return {neighbors + offsets[u], neighbors + offsets[u + 1]};
+    }
+
+    size_t degree(uint32_t u) const { return static_cast<size_t>(offsets[u + 1] - offsets[u]); }
+    size_t edgeCount() const { return static_cast<size_t>(offsets[n] / 2); }
+    bool hasEdgeIds() const { return edgeIds != nullptr; }
+};
+
+// Compressed sparse row adjacency: the neighbours of u are
+// neighbors[offsets[u] .. offsets[u + 1]), and every undirected edge is
+// stored once from each endpoint. Vertex ids are Index wide and slots
+// Offset wide; CSRGraph, 32-bit both, is what the rest of the code and the
+// binary file format use. edgeIds is optional and, when present, holds the
+// input edge index behind each neighbour slot.
+template <typename Index, typename Offset>
+struct BasicCSRGraph {
+    uint32_t n = 0;
+    std::vector<Offset> offsets;
+    std::vector<Index> neighbors;
+    std::vector<Offset> edgeIds;
+
+    using View = BasicCSRView<Index, Offset>;
+    using Neighbors = typename View::Neighbors;
+
+    Neighbors operator[](uint32_t u) const {
+        const Index* row = neighbors.data();
+        return {row + offsets[u], row + offsets[u + 1]};
+    }
+
+    View view() const {
+        return {n, offsets.data(), neighbors.data(), edgeIds.empty() ? nullptr : edgeIds.data()};
+    }
+
+    size_t degree(uint32_t u) const { return static_cast<size_t>(offsets[u + 1] - offsets[u]); }
+    size_t edgeCount() const { return neighbors.size() / 2; }
+    bool hasEdgeIds() const { return !edgeIds.empty(); }
+
+    // arrays held, by capacity
+    size_t bytes() const {
+        return (offsets.capacity() + edgeIds.capacity()) * sizeof(Offset) + neighbors.capacity() * sizeof(Index);
+    }
+
+    // builds the rows in two counting passes: degrees, then placement
+    static BasicCSRGraph fromEdges(uint32_t n, const std::vector<Edge>& edges, bool withEdgeIds = false) {
+        BasicCSRGraph g;
+        g.assign(n, edges.data(), edges.size(), withEdgeIds);
+        return g;
+    }
+
+    // same as fromEdges(), rebuilding this graph in place: the arrays keep
+    // their capacity, so a graph reused for many small inputs stops
+    // allocating once it has seen the largest one
+    void assign(uint32_t vertices, const Edge* edges, size_t count, bool withEdgeIds = false) {
+        if (vertices > 0 && vertices - 1 > std::numeric_limits<Index>::max()) {
+            throw std::length_error("Too many vertices for " + std::to_string(8 * sizeof(Index)) + "-bit CSR indices");
+        }
+        if (count > std::numeric_limits<Offset>::max() / 2) {
+            throw std::length_error("Too many edges for " + std::to_string(8 * sizeof(Offset)) + "-bit CSR offsets");
+        }
+
+        n = vertices;
+        offsets.assign(static_cast<size_t>(n) + 1, 0);
+        for (size_t i = 0; i < count; i++) {
+            const Edge& e = edges[i];
+            if (e.u < 0 || static_cast<uint32_t>(e.u) >= n || e.v < 0 || static_cast<uint32_t>(e.v) >= n) {
+                throw std::invalid_argument("Invalid vertex index");
+            }
+            offsets[e.u]++;
+            offsets[e.v]++;
+        }
+        // offsets[u] becomes the end of row u; placing the edges backwards
+        // walks it down to the start of the row with the input order kept
+        for (uint32_t u = 1; u < n; u++) {
+            offsets[u] += offsets[u - 1];
+        }
+        offsets[n] = static_cast<Offset>(2 * count);
+
+        neighbors.resize(2 * count);
+        if (withEdgeIds) {
+            edgeIds.resize(2 * count);
+        } else {
+            edgeIds.clear();
+        }
+        for (size_t i = count; i-- > 0;) {
+            uint32_t u = edges[i].u, v = edges[i].v;
+            Offset b = --offsets[v];
+            Offset a = --offsets[u];
+            neighbors[a] = static_cast<Index>(v);
+            neighbors[b] = static_cast<Index>(u);
+            if (withEdgeIds) {
+                edgeIds[a] = edgeIds[b] = static_cast<Offset>(i);
+            }
+        }
+    }
+};
+
+using CSRView = BasicCSRView<uint32_t, uint32_t>;
+using CSRGraph = BasicCSRGraph<uint32_t, uint32_t>;
+
+// One adjacency bit row per vertex, for dense graphs: bit v of row u is set
+// when (u, v) is an edge. Rows are padded to whole 64-bit words, so a
+// search can test a row against a visited bitset a word at a time instead
+// of reading the neighbours one by one. Above a density of 1/32 the matrix
+// is smaller than the CSR arrays it is built from.
+struct BitMatrix {
+    uint32_t n = 0;
+    size_t words = 0;               // per row
+    std::vector<uint64_t> bits;
+
+    // rebuilds the rows from g; the array keeps its capacity
+    template <typename Graph>
+    void assign(const Graph& g) {
+        n = g.n;
+        words = (static_cast<size_t>(n) + 63) / 64;
+        bits.assign(n * words, 0);
+        for (uint32_t u = 0; u < n; u++) {
+            // a sorted row fills one word at a time in a register
+            uint64_t* r = &bits[u * words];
+            uint32_t at = 0;
+            uint64_t word = 0;
+            for (uint32_t v : g[u]) {
+                if (v / 64 != at) {
+                    r[at] |= word;
+                    at = v / 64;
+                    word = 0;
+                }
+                word |= uint64_t(1) << (v % 64);
+            }
+            r[at] |= word;
+        }
+    }
+
+    void clear() {
+        n = 0;
+        words = 0;
+        bits.clear();
+    }
+
+    bool empty() const { return words == 0; }
+    const uint64_t* row(uint32_t u) const { return bits.data() + u * words; }
+    size_t bytes() const { return bits.capacity() * sizeof(uint64_t); }
+
+    // a cleared bitset over the n vertices, for the masks below
+    static void resetMask(std::pmr::vector<uint64_t>& mask, uint32_t n) {
+        mask.assign((static_cast<size_t>(n) + 63) / 64, 0);
+    }
+
+    static void setBit(uint64_t* mask, uint32_t v) { mask[v / 64] |= uint64_t(1) << (v % 64); }
+    static void clearBit(uint64_t* mask, uint32_t v) { mask[v / 64] &= ~(uint64_t(1) << (v % 64)); }
+
+    // Calls fn(v), in ascending order, for every v set in row and clear in
+    // both masks (row AND NOT (a OR b)), until fn returns true; returns
+    // whether it did. The masks are re-read after every call, so bits fn
+    // sets in them are skipped. Runs of words with nothing left are
+    // skipped 512 or 256 bits at a time when the compiler targets AVX-512
+    // or AVX2 (-march=native), one word at a time otherwise.
+    template <typename Fn>
+    static bool forEachAndNot(const uint64_t* row, const uint64_t* a, const uint64_t* b, size_t words, Fn fn) {
+        size_t i = 0;
+#if defined(__AVX512F__)
+        for (; i + 8 <= words; i += 8) {
+            // 0x10 is the truth table of row & ~(a | b)
+            __m512i left = _mm512_ternarylogic_epi64(_mm512_loadu_si512(row + i), _mm512_loadu_si512(a + i),
+                                                     _mm512_loadu_si512(b + i), 0x10);
+            if (_mm512_test_epi64_mask(left, left) == 0) continue;
+            for (size_t j = i; j < i + 8; j++) {
+                if (scanWord(row, a, b, j, fn)) return true;
+            }
+        }
+#elif defined(__AVX2__)
+        for (; i + 4 <= words; i += 4) {
+            __m256i masked = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                             _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+            __m256i left = _mm256_andnot_si256(masked, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i)));
+            if (_mm256_testz_si256(left, left)) continue;
+            for (size_t j = i; j < i + 4; j++) {
+                if (scanWord(row, a, b, j, fn)) return true;
+            }
+        }
+#endif
+        for (; i < words; i++) {
+            if (scanWord(row, a, b, i, fn)) return true;
+        }
+        return false;
+    }
+
+private:
+    template <typename Fn>
+    static bool scanWord(const uint64_t* row, const uint64_t* a, const uint64_t* b, size_t i, Fn& fn) {
+        uint64_t left = row[i] & ~(a[i] | b[i]);
+        while (left != 0) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctzll(left));
+            if (fn(static_cast<int>(i * 64 + bit))) return true;
+            left &= (left - 1) & ~(a[i] | b[i]);
+        }
+        return false;
+    }
+};
+
+// matching engine used to build the matching the cover is completed from
+enum class MatchingEngine {
+    Auto,       // best exact engine for the input
+    Greedy,     // fast approximate: greedy matching + BFS improvement rounds
+    Blossom,    // exact maximum matching on general graphs (Edmonds)
+    HopcroftKarp // exact maximum matching on bipartite graphs
+};
+
+inline const char* engineName(MatchingEngine engine) {
+    switch (engine) {
+        case MatchingEngine::Auto: return "auto";
+        case MatchingEngine::Greedy: return "greedy";
+        case MatchingEngine::Blossom: return "blossom";
+        case MatchingEngine::HopcroftKarp: return "hopcroft-karp";
+    }
+    return "unknown";
+}
+
+// vertex numbering the engines run on, SolverOptions::reorder
+enum class VertexOrder {
+    Input,                  // as given
+    Degree,                 // degree descending, hubs first
+    BFS,                    // breadth-first, one component after another
+    ReverseCuthillMcKee     // RCM: BFS from a low-degree vertex, neighbours by degree, reversed
+};
+
+inline const char* orderName(VertexOrder order) {
+    switch (order) {
+        case VertexOrder::Input: return "input";
+        case VertexOrder::Degree: return "degree";
+        case VertexOrder::BFS: return "bfs";
+        case VertexOrder::ReverseCuthillMcKee: return "rcm";
+    }
+    return "unknown";
+}
+
+// Cooperative stop request for a solve running on another thread, the
+// deadline passing or cancel() being called. The augmenting engines poll
+// it between searches; the warm start and the cover completion always run
+// to the end. A stopped solve keeps the matching found so far, so its
+// cover is still an edge cover, only CoverResult::gapBound above minimum.
+class StopSignal {
+private:
+    std::atomic<bool> cancelled{false};
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
+public:
+    StopSignal() = default;
+    explicit StopSignal(std::chrono::steady_clock::time_point deadline) : deadline(deadline) {}
+
+    StopSignal(const StopSignal&) = delete;
+    StopSignal& operator=(const StopSignal&) = delete;
+
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    bool stopRequested() const {
+        return isCancelled() || (deadline != std::chrono::steady_clock::time_point::max() &&
+                                 std::chrono::steady_clock::now() >= deadline);
+    }
+};
+
+// An engine's side of a StopSignal: due() reads the signal on its first
+// call and every 64th after, so a search loop can poll it at no measurable
+// cost, and now() reads it at once. A stop once seen stays seen; with no
+// signal neither fires.
+struct StopPoll {
+    const StopSignal* signal = nullptr;
+    unsigned calls = 0;
+    bool seen = false;
+
+    bool now() {
+        if (signal != nullptr && !seen) seen = signal->stopRequested();
+        return seen;
+    }
+
+    bool due() { return seen || (signal != nullptr && calls++ % 64 == 0 && now()); }
+};
+
+struct SolverOptions {
+    MatchingEngine engine = MatchingEngine::Auto;
+    unsigned threads = 1;   // worker threads for the parallel stages, 0 = one per hardware thread
+
+    // Where the buffers of one solve come from. By default the solver keeps
+    // them between solves on the global heap. With memory set they are
+    // taken from that resource for each solve and returned after it; with
+    // arenaBytes set as well each solve bump-allocates them from one block
+    // of that size (about 40 bytes per vertex is enough for every engine)
+    // that is freed at once when the solve returns. The sub-solves of
+    // components, of the reduced kernel and of a reordered copy take their
+    // buffers from the same place. The mate array, graph copies and the
+    // parallel warm start and Hopcroft-Karp buffers stay on the heap.
+    std::pmr::memory_resource* memory = nullptr;
+    size_t arenaBytes = 0;
+
+    // settle degree-1 and degree-2 vertices first (MatchingReducer) and
+    // hand only the kernel left by them to the engine
+    bool reduce = false;
+
+    // adjacency slots per vertex pair (2|E| / V^2) from which the exact
+    // engines search a BitMatrix instead of the CSR rows; 0 never does.
+    // The Greedy engine reads every row about twice and always uses CSR
+    double denseThreshold = 1.0 / 32;
+
+    // With an order other than Input, each solve renumbers the vertices in
+    // that order, so neighbours tend to get nearby ids, and matches a
+    // relabelled copy of the graph; the mates are mapped back before the
+    // cover is completed on the input graph
+    VertexOrder reorder = VertexOrder::Input;
+
+    // With epsilon > 0 the exact engines stop looking for augmenting paths
+    // once every path left would be longer than augmentingPathLimit()
+    // edges; CoverResult::gapBound then says how far from minimum the
+    // cover may be. Hopcroft-Karp is then within a factor 1 - epsilon of a
+    // maximum matching. Blossom searches are cut at the same depth, but a
+    // search through blossoms can miss a short path, so only the bound
+    // counts there. 0 always matches exactly
+    double epsilon = 0;
+
+    // when set, polled by the engines: a stop ends the search for
+    // augmenting paths early and CoverResult::stopped tells so. It must
+    // outlive every solve that reads it
+    const StopSignal* stop = nullptr;
+};
+
+// the longest augmenting path an epsilon-limited solve still looks for,
+// 2 * ceil(1 / epsilon) + 1 edges; INT_MAX for an exact solve
+inline int augmentingPathLimit(double epsilon) {
+    if (!(epsilon > 0) || epsilon < 1e-6) return INT_MAX;
+    return 2 * static_cast<int>(std::ceil(1 / epsilon)) + 1;
+}
+
+inline unsigned resolveThreads(unsigned requested) {
+    if (requested != 0) return requested;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw != 0 ? hw : 1;
+}
+
+// Runs fn(worker, begin, end) over [0, count) in fixed-size chunks that the
+// workers pull from a shared counter, so skewed rows do not stall a thread.
+// Worker 0 is the calling thread; with one worker nothing is spawned.
+template <typename Fn>
+void parallelChunks(unsigned threads, size_t count, Fn fn, size_t chunk = 1024) {
+    threads = static_cast<unsigned>(std::min<size_t>(threads, (count + chunk - 1) / chunk));
+    if (threads <= 1) {
+        if (count > 0) fn(0u, size_t(0), count);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto work = [&](unsigned worker) {
+        for (;;) {
+            size_t begin = next.fetch_add(chunk, std::memory_order_relaxed);
+            if (begin >= count) break;
+            fn(worker, begin, std::min(begin + chunk, count));
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned w = 1; w < threads; w++) {
+        pool.emplace_back(work, w);
+    }
+    work(0);
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+struct CoverResult {
+    std::vector<Edge> edges;
+    MatchingEngine engine = MatchingEngine::Auto;   // engine that actually ran
+    int matchingSize = 0;
+    int augmentations = 0;      // augmenting paths applied after the warm start
+    int gapBound = 0;           // at most this many edges above a minimum cover; 0 when exact
+    bool stopped = false;       // a StopSignal cut the matching short
+    int seedKept = 0;           // warm-start pairs kept, 0 for an unseeded solve
+    int seedDropped = 0;        // and dropped: not edges, not mutual or overlapping
+    int seedUnpaired = 0;       // edges of an edge-set seed left out of its pairs
+
+    // wall time of the two stages of solve()
+    std::chrono::nanoseconds matchingTime{0};
+    std::chrono::nanoseconds completionTime{0};
+};
+
+// Proof that mates is a maximum matching. By the Tutte-Berge formula no
+// matching is larger than (n + |S| - odd(G - S)) / 2 for any vertex set S,
+// where odd() counts the components of odd size. The Gallai-Edmonds set S
+// (the vertices next to one that some maximum matching leaves exposed,
+// without being one) meets the bound. CoverVerifier checks it.
+struct MatchingCertificate {
+    std::vector<int> mates;
+    std::vector<int> barrier;   // S, ascending
+};
+
+// Work counters the engines report into, chosen by template parameter.
+// NoCounters is the default and every call on it compiles away;
+// WorkCounters tallies them for SolveStats.
+struct NoCounters {
+    void scanVertex() {}
+    void scanEdges(size_t) {}
+    void round() {}
+    void level(uint32_t, uint32_t, bool) {}
+    void merge(const NoCounters&) {}
+};
+
+struct WorkCounters {
+    uint64_t verticesScanned = 0;   // vertices taken off a search queue or stack
+    uint64_t edgesScanned = 0;      // adjacency entries read by the searches
+    uint64_t rounds = 0;            // blossom searches, Hopcroft-Karp phases, BFS passes
+
+    // the direction-optimizing Hopcroft-Karp layering: levels expanded
+    // bottom-up, and every change of direction, by phase of its matcher
+    // (from 1) and BFS level
+    struct DirectionSwitch {
+        uint32_t phase, level;
+        bool bottomUp;
+    };
+    uint64_t bottomUpLevels = 0;
+    std::vector<DirectionSwitch> switches;
+
+    void scanVertex() { verticesScanned++; }
+    void scanEdges(size_t count) { edgesScanned += count; }
+    void round() { rounds++; }
+    void level(uint32_t phase, uint32_t depth, bool bottomUp) {
+        bool was = !switches.empty() && switches.back().phase == phase && switches.back().bottomUp;
+        if (bottomUp) bottomUpLevels++;
+        if (bottomUp != was) switches.push_back({phase, depth, bottomUp});
+    }
+    void merge(const WorkCounters& other) {
+        verticesScanned += other.verticesScanned;
+        edgesScanned += other.edgesScanned;
+        rounds += other.rounds;
+        bottomUpLevels += other.bottomUpLevels;
+        switches.insert(switches.end(), other.switches.begin(), other.switches.end());
+    }
+};
+
+// optional per-phase breakdown filled by MinEdgeCover::solveDetailed(stats)
+struct SolveStats {
+    int vertices = 0;
+    size_t edges = 0;
+
+    std::chrono::nanoseconds warmStartTime{0};     // greedy / Karp-Sipser matching
+    std::chrono::nanoseconds augmentTime{0};       // exact (or BFS improvement) phase
+    std::chrono::nanoseconds completionTime{0};    // matching edges + cover completion
+
+    int initialMatchingSize = 0;    // after the warm start
+    int matchingSize = 0;
+    int augmentations = 0;
+    WorkCounters work;              // warm start and matching engine together
+
+    size_t workspaceBytes = 0;      // graph, mate array and the largest engine workspace
+
+    // with options.reduce; the phase times above are those of the kernel
+    std::chrono::nanoseconds reduceTime{0};   // reductions, kernel copy and lifting
+    int degreeOneMatches = 0;
+    int folds = 0;                  // degree-2 vertices folded into their neighbours
+    int kernelVertices = 0;
+    size_t kernelEdges = 0;
+
+    // with options.reorder; the phase times above are those of the
+    // relabelled graph
+    std::chrono::nanoseconds reorderTime{0};  // ordering, relabelled copy and mapping back
+};
+
+// Buffers an engine borrows for one run and hands back when it is
+// destroyed, so a solver that is reused for many graphs (MinEdgeCover::
+// assign(), BatchCoverSolver) allocates them only while they still grow.
+// The buffers allocate from the memory resource they were created with.
+struct BlossomScratch {
+    std::pmr::vector<int> parent, link, base, queue, touched, merged;
+    std::pmr::vector<uint32_t> seen, even, lcaMark, excluded;
+    std::pmr::vector<uint64_t> oddBits, excludedBits;
+
+    explicit BlossomScratch(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : parent(memory), link(memory), base(memory), queue(memory), touched(memory), merged(memory),
+          seen(memory), even(memory), lcaMark(memory), excluded(memory), oddBits(memory), excludedBits(memory) {}
+
+    std::pmr::memory_resource* resource() const { return parent.get_allocator().resource(); }
+};
+
+struct HopcroftKarpScratch {
+    std::pmr::vector<int> dist, queue, stack, right;
+    std::pmr::vector<size_t> next;
+    std::pmr::vector<uint64_t> reached;
+
+    explicit HopcroftKarpScratch(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : dist(memory), queue(memory), stack(memory), right(memory), next(memory), reached(memory) {}
+
+    std::pmr::memory_resource* resource() const { return dist.get_allocator().resource(); }
+};
+
+// Serializes the calls into upstream, so workers solving components at
+// once can grow their workspaces from one arena of the parent solve
+class SynchronizedResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream;
+    std::mutex lock;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        std::lock_guard<std::mutex> guard(lock);
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::lock_guard<std::mutex> guard(lock);
+        upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    explicit SynchronizedResource(std::pmr::memory_resource* upstream) : upstream(upstream) {}
+};
+
+// the resource an engine allocates from; swapping its buffers with the
+// scratch ones needs both on the same resource
+template <typename Scratch>
+std::pmr::memory_resource* scratchResource(const Scratch* scratch) {
+    return scratch ? scratch->resource() : std::pmr::get_default_resource();
+}
+
+struct KarpSipserScratch {
+    std::unique_ptr<std::atomic<int>[]> degree;
+    std::unique_ptr<std::atomic<uint8_t>[]> claimed;
+    size_t capacity = 0;                    // entries in degree and claimed
+    std::vector<std::vector<int>> queues;   // one per worker
+};
+
+// MatchingReducer state, kept between runs like KarpSipserScratch
+struct ReductionScratch {
+    struct Fold {
+        int v, u, w;                  // v was dropped, the sets u and w merged
+        int kept, absorbed;           // the larger of the two sets, and the other
+        int keptLast, absorbedLast;   // last members of both before the merge
+        Edge toU, toW;                // input edges from v's set into u's and w's
+    };
+
+    std::vector<int> owner;           // union-find parent, the set root is the vertex
+    std::vector<int> nextMember, lastMember;
+    std::vector<uint32_t> slots;      // adjacency slots of all members, for the merge order
+    std::vector<int> degree;          // slots to other live sets
+    std::vector<uint8_t> state;
+    std::vector<int> carrier;         // member whose matching edge covers the set, or -1
+    std::vector<int> ones, twos;      // bucket queue: degree at most one, degree two
+    std::vector<Fold> folds;
+    std::vector<int> kernel;          // set roots left after the reductions
+
+    size_t bytes() const {
+        return (owner.capacity() + nextMember.capacity() + lastMember.capacity() + slots.capacity() +
+                degree.capacity() + carrier.capacity() + ones.capacity() + twos.capacity() + kernel.capacity()) * 4 +
+               state.capacity() + folds.capacity() * sizeof(Fold);
+    }
+};
+
+// Edmonds' blossom algorithm. Every free vertex is the root of one
+// alternating-tree search and odd cycles are contracted on the fly, so the
+// result is a maximum matching on any graph. A single sweep over the free
+// vertices does all augmentations: a search only resets the vertices it
+// touched, blossom bases live in a union-find so a contraction costs only
+// the length of the cycle, and a tree that fails to augment (a Hungarian
+// tree) can never lie on an augmenting path again, so its vertices are
+// dropped for the rest of the run.
+//
+// Graph is anything where graph[u] iterates over the neighbours of u.
+template <typename Graph, typename Counters = NoCounters>
+class BlossomMatcher {
+private:
+    const Graph& graph;
+    int n;
+    std::vector<int>& match;
+    Counters counters;
+
+    std::pmr::vector<int> parent, link, base, queue, touched, merged;
+    std::pmr::vector<uint32_t> seen, even, lcaMark, excluded;
+    std::pmr::vector<uint64_t> oddBits, excludedBits;    // with rows: odd tree vertices, exclusions
+    BlossomScratch* scratch;
+    const BitMatrix* rows = nullptr;
+    uint32_t tree = 0, mark = 0, epoch = 1;
+    size_t searchLimit = SIZE_MAX;
+    int maxDepth = INT_MAX;         // even levels a search expands beyond its root
+    bool truncated = false;
+    int open = 0;                   // exposed roots left by run() whose search was cut
+    StopPoll stop;
+
+    bool isExcluded(int v) const { return excluded[v] == epoch; }
+
+    int parentOf(int v) const { return seen[v] == tree ? parent[v] : -1; }
+
+    int find(int v) {
+        if (seen[v] != tree) return v;
+        int root = v;
+        while (link[root] != root) root = link[root];
+        while (link[v] != root) {
+            int next = link[v];
+            link[v] = root;
+            v = next;
+        }
+        return root;
+    }
+
+    int baseOf(int v) { return seen[v] == tree ? base[find(v)] : v; }
+
+    void touch(int v) {
+        if (seen[v] == tree) return;
+        seen[v] = tree;
+        parent[v] = -1;
+        link[v] = v;
+        base[v] = v;
+        touched.push_back(v);
+    }
+
+    void pushEven(int v) {
+        touch(v);
+        if (even[v] == tree) return;
+        even[v] = tree;
+        if (rows) BitMatrix::clearBit(oddBits.data(), v);
+        queue.push_back(v);
+    }
+
+    int lca(int a, int b) {
+        ++mark;
+        for (;;) {
+            a = baseOf(a);
+            lcaMark[a] = mark;
+            if (match[a] == -1) break;
+            a = parent[match[a]];
+        }
+        for (;;) {
+            b = baseOf(b);
+            if (lcaMark[b] == mark) return b;
+            b = parent[match[b]];
+        }
+    }
+
+    // walks the tree path from v up to base b, redirecting parent pointers
+    // around the new blossom and collecting the sub-blossoms it swallows
+    void markPath(int v, int b, int child) {
+        while (baseOf(v) != b) {
+            int w = match[v];
+            merged.push_back(find(v));
+            merged.push_back(find(w));
+            parent[v] = child;
+            child = w;
+            v = parent[w];
+        }
+    }
+
+    // contracts the odd cycle closed by the even-even edge (u, v); the odd
+    // vertices on it become even and join the queue
+    void contract(int u, int v) {
+        int b = lca(u, v);
+        merged.clear();
+        markPath(u, b, v);
+        markPath(v, b, u);
+        int root = find(b);
+        for (int x : merged) {
+            link[x] = root;
+            pushEven(x);
+        }
+    }
+
+    // the edge (u, v) from the even vertex u: contracts a blossom or grows
+    // the tree; returns v if it ends an augmenting path, otherwise -1
+    int visit(int root, int firstHop, int u, int v) {
+        if (isExcluded(v) || match[u] == v || baseOf(u) == baseOf(v)) return -1;
+        if (u == root && firstHop != -1 && v != firstHop) return -1;
+
+        if (v == root || (match[v] != -1 && parentOf(match[v]) != -1)) {
+            contract(u, v);
+        } else if (parentOf(v) == -1) {
+            touch(v);
+            parent[v] = u;
+            if (rows) BitMatrix::setBit(oddBits.data(), v);
+            if (match[v] == -1) return v;
+            pushEven(match[v]);
+        }
+        return -1;
+    }
+
+    // returns the free endpoint of an augmenting path starting at root, or -1;
+    // firstHop != -1 restricts the root to that single neighbour. With bit
+    // rows, odd and excluded vertices (on which visit() does nothing) are
+    // masked out of a row a word at a time
+    int findPath(int root, int firstHop = -1) {
+        ++tree;
+        if (rows) {
+            for (int x : touched) BitMatrix::clearBit(oddBits.data(), x);
+        }
+        touched.clear();
+        queue.clear();
+        pushEven(root);
+        counters.round();
+
+        // the queue holds the even vertices level by level, a contracted
+        // blossom joining the level after the vertex that closed it
+        size_t levelEnd = queue.size();
+        int depth = 0;
+        for (size_t head = 0; head < queue.size(); head++) {
+            if (head == levelEnd) {
+                levelEnd = queue.size();
+                if (++depth > maxDepth) {
+                    truncated = true;
+                    return -1;
+                }
+            }
+            if (touched.size() > searchLimit) {
+                truncated = true;
+                return -1;
+            }
+            int u = queue[head];
+            counters.scanVertex();
+            int end = -1;
+            if (rows) {
+                counters.scanEdges(rows->words);
+                BitMatrix::forEachAndNot(rows->row(u), oddBits.data(), excludedBits.data(), rows->words, [&](int v) {
+                    end = visit(root, firstHop, u, v);
+                    return end != -1;
+                });
+            } else {
+                counters.scanEdges(graph[u].size());
+                for (int v : graph[u]) {
+                    end = visit(root, firstHop, u, v);
+                    if (end != -1) break;
+                }
+            }
+            if (end != -1) return end;
+        }
+        return -1;
+    }
+
+    void augment(int v) {
+        while (v != -1) {
+            int pv = parent[v];
+            int ppv = match[pv];
+            match[v] = pv;
+            match[pv] = v;
+            v = ppv;
+        }
+    }
+
+    void swapBuffers(BlossomScratch& other) {
+        parent.swap(other.parent);
+        link.swap(other.link);
+        base.swap(other.base);
+        queue.swap(other.queue);
+        touched.swap(other.touched);
+        merged.swap(other.merged);
+        seen.swap(other.seen);
+        even.swap(other.even);
+        lcaMark.swap(other.lcaMark);
+        excluded.swap(other.excluded);
+        oddBits.swap(other.oddBits);
+        excludedBits.swap(other.excludedBits);
+    }
+
+public:
+    BlossomMatcher(const Graph& graph, int n, std::vector<int>& match, BlossomScratch* scratch = nullptr)
+        : graph(graph), n(n), match(match), parent(scratchResource(scratch)), link(parent.get_allocator()),
+          base(parent.get_allocator()), queue(parent.get_allocator()), touched(parent.get_allocator()),
+          merged(parent.get_allocator()), seen(parent.get_allocator()), even(parent.get_allocator()),
+          lcaMark(parent.get_allocator()), excluded(parent.get_allocator()), oddBits(parent.get_allocator()),
+          excludedBits(parent.get_allocator()), scratch(scratch) {
+        if (scratch) swapBuffers(*scratch);
+        parent.assign(n, -1);
+        link.resize(n);
+        base.resize(n);
+        seen.assign(n, 0);
+        even.assign(n, 0);
+        lcaMark.assign(n, 0);
+        excluded.assign(n, 0);
+        queue.clear();
+        queue.reserve(n);
+        touched.clear();
+        touched.reserve(n);
+    }
+
+    ~BlossomMatcher() {
+        if (scratch) swapBuffers(*scratch);
+    }
+
+    BlossomMatcher(const BlossomMatcher&) = delete;
+    BlossomMatcher& operator=(const BlossomMatcher&) = delete;
+
+    const Counters& work() const { return counters; }
+
+    size_t memoryBytes() const {
+        return (parent.capacity() + link.capacity() + base.capacity() + queue.capacity() + touched.capacity() +
+                merged.capacity() + seen.capacity() + even.capacity() + lcaMark.capacity() + excluded.capacity()) * 4 +
+               (oddBits.capacity() + excludedBits.capacity()) * sizeof(uint64_t);
+    }
+
+    // searches the rows of matrix, the same graph as bits, from now on
+    void useBitRows(const BitMatrix* matrix) {
+        rows = matrix;
+        if (!rows) return;
+        BitMatrix::resetMask(oddBits, n);
+        BitMatrix::resetMask(excludedBits, n);
+        for (int v = 0; v < n; v++) {
+            if (isExcluded(v)) BitMatrix::setBit(excludedBits.data(), v);
+        }
+    }
+
+    // caps the vertices one augmentFrom() search may label; a search that
+    // hits the cap gives up and reports lastSearchTruncated()
+    void setSearchLimit(size_t limit) { searchLimit = limit; }
+    bool lastSearchTruncated() const { return truncated; }
+
+    // makes run() expand only the levels that can end a path of at most
+    // length edges. A cut search proves nothing, so its root stays open:
+    // every augmenting path left joins two of the openRoots()
+    void setMaxPathLength(int length) { maxDepth = (length - 1) / 2; }
+    int openRoots() const { return open; }
+
+    // makes run() give up, with the roots not searched yet left open, once
+    // signal asks it to stop; interrupted() tells whether it did
+    void setStopSignal(const StopSignal* signal) { stop = {signal}; }
+    bool interrupted() const { return stop.seen; }
+
+    // hides v from searches until clearExclusions()
+    void exclude(int v) {
+        excluded[v] = epoch;
+        if (rows) BitMatrix::setBit(excludedBits.data(), v);
+    }
+
+    void clearExclusions() {
+        ++epoch;
+        if (rows) std::fill(excludedBits.begin(), excludedBits.end(), 0);
+    }
+
+    // one search from the exposed vertex root; on success the path is
+    // flipped and its other endpoint returned, otherwise -1 and match is
+    // left untouched. A path known to start with the edge (root, firstHop)
+    // can pass that neighbour to keep the search off root's other edges
+    int augmentFrom(int root, int firstHop = -1) {
+        truncated = false;
+        int end = findPath(root, firstHop);
+        if (end != -1) augment(end);
+        return end;
+    }
+
+    // extends match to a maximum matching, returns the number of
+    // augmentations. Vertices excluded before the call are left out of it
+    // (the caller knows they cannot lie on an augmenting path); all
+    // exclusions are cleared on return
+    int run() {
+        size_t limit = searchLimit;
+        searchLimit = SIZE_MAX;
+        int augmentations = 0;
+        bool cut = false;
+        for (int root = 0; root < n; root++) {
+            if (match[root] != -1 || isExcluded(root)) continue;
+            if (stop.due()) {
+                cut = true;
+                break;
+            }
+            truncated = false;
+            int end = findPath(root);
+            if (end != -1) {
+                augment(end);
+                augmentations++;
+            } else if (truncated) {
+                cut = true;
+            } else {
+                for (int x : touched) exclude(x);
+            }
+        }
+        open = 0;
+        for (int v = 0; cut && v < n; v++) {
+            if (match[v] == -1 && !isExcluded(v)) open++;
+        }
+        clearExclusions();
+        searchLimit = limit;
+        return augmentations;
+    }
+
+    // For a maximum matching: sets outer[v] for every vertex that some
+    // maximum matching leaves exposed, the set D of the Gallai-Edmonds
+    // decomposition. These are the even vertices of the Hungarian trees
+    // grown from the exposed vertices, each tree dropped once it is done.
+    // Returns false, with the matching untouched, if a search augments
+    bool markExposable(std::vector<uint8_t>& outer) {
+        size_t limit = searchLimit;
+        searchLimit = SIZE_MAX;
+        outer.assign(n, 0);
+        bool maximum = true;
+        for (int root = 0; root < n; root++) {
+            if (match[root] != -1 || isExcluded(root)) continue;
+            if (findPath(root) != -1) {
+                maximum = false;
+                break;
+            }
+            for (int x : touched) {
+                if (even[x] == tree) outer[x] = 1;
+                exclude(x);
+            }
+        }
+        clearExclusions();
+        searchLimit = limit;
+        return maximum;
+    }
+};
+
+// Direction-optimizing choice (after Beamer et al.) for the Hopcroft-Karp
+// layering. A top-down level reads the whole row of every frontier vertex.
+// A bottom-up level reads the row of every right vertex not reached yet,
+// but only up to its first neighbour in the frontier: with the frontier
+// holding a share h of the left slots, about min(degree, 1/h) slots each.
+// That wins once the frontier is a large part of a low-diameter graph.
+// Beamer's fixed ratios switch too early here: an alternating level only
+// reaches the mates of the frontier, and on sparse graphs most rows
+// scanned bottom-up then end without a hit, so both costs are estimated
+// and the cheaper side taken.
+struct DirectionPolicy {
+    size_t slots = 0;           // row slots of all right vertices, the same as of all left ones
+    size_t unexplored = 0;      // row slots of the right vertices not reached yet
+    size_t unexploredVertices = 0;
+
+    void reset(size_t rightVertices, size_t rightSlots) {
+        slots = rightSlots;
+        unexplored = rightSlots;
+        unexploredVertices = rightVertices;
+    }
+
+    // right vertices with rowSlots slots between them were reached
+    void explore(size_t rowSlots, size_t vertices = 1) {
+        unexplored -= rowSlots;
+        unexploredVertices -= vertices;
+    }
+
+    // direction of the next level, from the slots of its left vertices
+    bool bottomUp(size_t frontierSlots) const {
+        if (frontierSlots == 0 || unexploredVertices == 0) return false;
+        double perVertex = std::min(static_cast<double>(unexplored) / unexploredVertices,
+                                    static_cast<double>(slots) / frontierSlots);
+        return perVertex * unexploredVertices < frontierSlots;
+    }
+
+    // the right vertices a layering can reach: side 1 with left
+    // neighbours (tree components are all on side 1), and their slots
+    template <typename Graph, typename Vector>
+    static size_t rightVertices(const Graph& graph, int n, const std::vector<int8_t>& side, Vector& right) {
+        right.clear();
+        size_t slots = 0;
+        for (int v = 0; v < n; v++) {
+            if (side[v] == 1 && graph[v].size() > 0 && side[graph[v][0]] == 0) {
+                right.push_back(v);
+                slots += graph[v].size();
+            }
+        }
+        return slots;
+    }
+};
+
+// Hopcroft-Karp for bipartite graphs. Each phase builds BFS layers from all
+// free left vertices and then augments along a maximal set of vertex-disjoint
+// shortest paths with DFS, so only O(sqrt(V)) phases are needed.
+//
+// side[v] is 0 for left and 1 for right vertices; graph[u] must support
+// size() and operator[].
+template <typename Graph, typename Counters = NoCounters>
+class HopcroftKarpMatcher {
+private:
+    const Graph& graph;
+    int n;
+    const std::vector<int8_t>& side;
+    std::vector<int>& match;
+    Counters counters;
+
+    std::pmr::vector<int> dist, queue, stack;
+    std::pmr::vector<int> right;           // DirectionPolicy::rightVertices()
+    std::pmr::vector<size_t> next;
+    std::pmr::vector<uint64_t> reached;    // with rows: right vertices the layering reached
+    HopcroftKarpScratch* scratch;
+    const BitMatrix* rows = nullptr;
+    DirectionPolicy policy;
+    size_t rightSlots = 0;
+    uint32_t phase = 0;
+    int maxLength = INT_MAX;
+    bool cut = false;
+    StopPoll stop;
+
+    static constexpr int INF = INT_MAX;
+
+    // one right vertex v reached from the left vertex u; slots gathers
+    // the rows of the next level
+    void reach(int u, int v, int& limit, size_t& slots) {
+        int w = match[v];
+        if (w == -1) {
+            limit = dist[u] + 1;
+        } else if (dist[w] == INF) {
+            dist[w] = dist[u] + 1;
+            queue.push_back(w);
+            policy.explore(graph[v].size());
+            slots += graph[w].size();
+        }
+    }
+
+    // the right vertices of the next level found from their own rows
+    void bottomUpLevel(int depth, int& limit, size_t& slots) {
+        for (int v : right) {
+            int w = match[v];
+            if (w != -1 && dist[w] != INF) continue;
+            counters.scanVertex();
+            const auto& nbrs = graph[v];
+            size_t i = 0;
+            while (i < nbrs.size() && dist[nbrs[i]] != depth) i++;
+            counters.scanEdges(std::min(i + 1, nbrs.size()));
+            if (i < nbrs.size()) reach(static_cast<int>(nbrs[i]), v, limit, slots);
+        }
+    }
+
+    // layers the left vertices by alternating distance from the free ones,
+    // a level at a time, each expanded top-down or bottom-up as policy
+    // decides (bit rows are always read top-down)
+    bool buildLayers() {
+        queue.clear();
+        size_t slots = 0;
+        for (int u = 0; u < n; u++) {
+            if (side[u] == 0 && match[u] == -1) {
+                dist[u] = 0;
+                queue.push_back(u);
+                slots += graph[u].size();
+            } else {
+                dist[u] = INF;
+            }
+        }
+
+        // with bit rows every right vertex is looked at once per phase:
+        // a second visit could neither lower the limit nor label its mate
+        if (rows) std::fill(reached.begin(), reached.end(), 0);
+        int limit = INF;
+        counters.round();
+        policy.reset(right.size(), rightSlots);
+        phase++;
+        for (size_t begin = 0, end = queue.size(); begin < end && limit == INF; begin = end, end = queue.size()) {
+            int depth = dist[queue[begin]];
+            // a free right vertex reached from this level ends a path of
+            // 2 * depth + 1 edges
+            if (depth > (maxLength - 1) / 2) {
+                cut = true;
+                break;
+            }
+            bool bottomUp = !rows && policy.bottomUp(slots);
+            counters.level(phase, static_cast<uint32_t>(depth), bottomUp);
+            slots = 0;
+            if (bottomUp) {
+                bottomUpLevel(depth, limit, slots);
+                continue;
+            }
+            for (size_t head = begin; head < end; head++) {
+                int u = queue[head];
+                counters.scanVertex();
+                if (rows) {
+                    counters.scanEdges(rows->words);
+                    uint64_t* seen = reached.data();
+                    BitMatrix::forEachAndNot(rows->row(u), seen, seen, rows->words, [&](int v) {
+                        BitMatrix::setBit(seen, v);
+                        reach(u, v, limit, slots);
+                        return false;
+                    });
+                } else {
+                    counters.scanEdges(graph[u].size());
+                    for (int v : graph[u]) {
+                        reach(u, v, limit, slots);
+                    }
+                }
+            }
+        }
+        return limit != INF;
+    }
+
+    // iterative DFS along the layers; dead ends are removed from the layering
+    bool augmentFrom(int root) {
+        stack.clear();
+        stack.push_back(root);
+        while (!stack.empty()) {
+            int u = stack.back();
+            const auto& nbrs = graph[u];
+            bool advanced = false;
+            while (next[u] < nbrs.size()) {
+                int v = nbrs[next[u]++];
+                int w = match[v];
+                counters.scanEdges(1);
+                if (w == -1) {
+                    // flip the path held on the stack
+                    for (int x : stack) {
+                        int y = graph[x][next[x] - 1];
+                        match[x] = y;
+                        match[y] = x;
+                    }
+                    return true;
+                }
+                if (dist[w] == dist[u] + 1) {
+                    stack.push_back(w);
+                    counters.scanVertex();
+                    advanced = true;
+                    break;
+                }
+            }
+            if (!advanced) {
+                dist[u] = INF;
+                stack.pop_back();
+            }
+        }
+        return false;
+    }
+
+    void swapBuffers(HopcroftKarpScratch& other) {
+        dist.swap(other.dist);
+        queue.swap(other.queue);
+        stack.swap(other.stack);
+        right.swap(other.right);
+        next.swap(other.next);
+        reached.swap(other.reached);
+    }
+
+public:
+    HopcroftKarpMatcher(const Graph& graph, int n, const std::vector<int8_t>& side, std::vector<int>& match,
+                        HopcroftKarpScratch* scratch = nullptr)
+        : graph(graph), n(n), side(side), match(match), dist(scratchResource(scratch)),
+          queue(dist.get_allocator()), stack(dist.get_allocator()), right(dist.get_allocator()),
+          next(dist.get_allocator()), reached(dist.get_allocator()), scratch(scratch) {
+        if (scratch) swapBuffers(*scratch);
+        dist.resize(n);
+        next.resize(n);
+        queue.clear();
+        queue.reserve(n);
+    }
+
+    ~HopcroftKarpMatcher() {
+        if (scratch) swapBuffers(*scratch);
+    }
+
+    HopcroftKarpMatcher(const HopcroftKarpMatcher&) = delete;
+    HopcroftKarpMatcher& operator=(const HopcroftKarpMatcher&) = delete;
+
+    const Counters& work() const { return counters; }
+
+    size_t memoryBytes() const {
+        return (dist.capacity() + queue.capacity() + stack.capacity() + right.capacity()) * 4 +
+               next.capacity() * sizeof(size_t) + reached.capacity() * sizeof(uint64_t);
+    }
+
+    // builds the layers from the rows of matrix, the same graph as bits;
+    // the DFS keeps reading the CSR rows
+    void useBitRows(const BitMatrix* matrix) {
+        rows = matrix;
+        if (rows) BitMatrix::resetMask(reached, n);
+    }
+
+    // makes run() stop once the shortest augmenting path is longer than
+    // length edges; stoppedShort() tells whether it did
+    void setMaxPathLength(int length) { maxLength = length; }
+    bool stoppedShort() const { return cut; }
+
+    // makes run() give up, between two searches of a phase or before the
+    // next phase, once signal asks it to stop; interrupted() tells whether
+    // it did
+    void setStopSignal(const StopSignal* signal) { stop = {signal}; }
+    bool interrupted() const { return stop.seen; }
+
+    // extends match to a maximum matching, returns the number of augmentations
+    int run() {
+        int augmentations = 0;
+        cut = false;
+        rightSlots = DirectionPolicy::rightVertices(graph, n, side, right);
+        while (!stop.now() && buildLayers()) {
+            std::fill(next.begin(), next.end(), 0);
+            for (int u = 0; u < n; u++) {
+                if (side[u] != 0 || match[u] != -1) continue;
+                if (stop.due()) break;
+                if (augmentFrom(u)) augmentations++;
+            }
+        }
+        return augmentations;
+    }
+};
+
+// Karp-Sipser warm start on several threads. A vertex left with a single
+// free neighbour is matched to it as soon as that happens (the choice the
+// sequential algorithm proves safe); everything else is matched greedily.
+// Both endpoints of an edge are claimed with compare-and-swap, so every
+// vertex is matched by exactly one thread without locks, and a claim that
+// loses a race is simply released. Two free neighbours can then release
+// each other at the same time, so with several threads a sequential pass
+// over the vertices still free follows. The result is a maximal matching
+// that the exact engines then complete, usually with few augmentations
+// left.
+template <typename Graph, typename Counters = NoCounters>
+class KarpSipserMatcher {
+private:
+    const Graph& graph;
+    int n;
+    std::vector<int>& match;
+    unsigned threads;
+
+    std::unique_ptr<std::atomic<int>[]> degree;       // edges to unclaimed vertices
+    std::unique_ptr<std::atomic<uint8_t>[]> claimed;
+    size_t capacity = 0;
+    std::vector<std::vector<int>> queues;             // degree-1 vertices found by each worker
+    std::vector<Counters> tallies;                    // per worker, empty for NoCounters
+    Counters counters;
+    KarpSipserScratch* scratch;
+
+    struct Worker {
+        std::vector<int>& queue;
+        Counters& counters;
+    };
+
+    // stateless counters are shared, so the no-op path allocates nothing
+    Worker worker(unsigned w) {
+        return {queues[w], std::is_empty<Counters>::value ? counters : tallies[w]};
+    }
+
+    void swapBuffers(KarpSipserScratch& other) {
+        degree.swap(other.degree);
+        claimed.swap(other.claimed);
+        std::swap(capacity, other.capacity);
+        queues.swap(other.queues);
+    }
+
+    bool isFree(int v) const {
+        return claimed[v].load(std::memory_order_relaxed) == 0;
+    }
+
+    bool claim(int v) {
+        uint8_t expected = 0;
+        return claimed[v].compare_exchange_strong(expected, 1, std::memory_order_acq_rel);
+    }
+
+    // u just got matched: its free neighbours lose an option
+    void retire(int u, Worker& worker) {
+        worker.counters.scanEdges(graph[u].size());
+        for (int w : graph[u]) {
+            if (w != u && degree[w].fetch_sub(1, std::memory_order_relaxed) == 2 && isFree(w)) {
+                worker.queue.push_back(w);
+            }
+        }
+    }
+
+    bool matchVertex(int u, Worker& worker) {
+        if (!claim(u)) return false;
+        worker.counters.scanVertex();
+        for (int v : graph[u]) {
+            worker.counters.scanEdges(1);
+            if (v != u && isFree(v) && claim(v)) {
+                match[u] = v;
+                match[v] = u;
+                retire(u, worker);
+                retire(v, worker);
+                return true;
+            }
+        }
+        claimed[u].store(0, std::memory_order_release);
+        return false;
+    }
+
+    // matches u, then every vertex that dropped to degree one on the way
+    void process(int u, Worker& worker) {
+        matchVertex(u, worker);
+        std::vector<int>& queue = worker.queue;
+        while (!queue.empty()) {
+            int w = queue.back();
+            queue.pop_back();
+            if (isFree(w) && degree[w].load(std::memory_order_relaxed) == 1) {
+                matchVertex(w, worker);
+            }
+        }
+    }
+
+public:
+    KarpSipserMatcher(const Graph& graph, int n, std::vector<int>& match, unsigned threads = 1,
+                      KarpSipserScratch* scratch = nullptr)
+        : graph(graph), n(n), match(match), threads(resolveThreads(threads)),
+          tallies(std::is_empty<Counters>::value ? 0 : this->threads), scratch(scratch) {
+        if (scratch) swapBuffers(*scratch);
+        if (capacity < static_cast<size_t>(n)) {
+            degree.reset(new std::atomic<int>[n]);
+            claimed.reset(new std::atomic<uint8_t>[n]);
+            capacity = n;
+        }
+        if (queues.size() < this->threads) queues.resize(this->threads);
+    }
+
+    ~KarpSipserMatcher() {
+        if (scratch) swapBuffers(*scratch);
+    }
+
+    KarpSipserMatcher(const KarpSipserMatcher&) = delete;
+    KarpSipserMatcher& operator=(const KarpSipserMatcher&) = delete;
+
+    const Counters& work() const { return counters; }
+
+    size_t memoryBytes() const {
+        size_t bytes = capacity * (sizeof(std::atomic<int>) + sizeof(std::atomic<uint8_t>));
+        for (const std::vector<int>& queue : queues) bytes += queue.capacity() * sizeof(int);
+        return bytes;
+    }
+
+    // extends the matching already in the mate array to a maximal one
+    void run() {
+        parallelChunks(threads, n, [&](unsigned, size_t begin, size_t end) {
+            for (size_t u = begin; u < end; u++) {
+                claimed[u].store(match[u] != -1, std::memory_order_relaxed);
+            }
+        });
+        parallelChunks(threads, n, [&](unsigned w, size_t begin, size_t end) {
+            for (size_t u = begin; u < end; u++) {
+                int live = 0;
+                worker(w).counters.scanEdges(graph[u].size());
+                for (int v : graph[u]) {
+                    if (v != static_cast<int>(u) && match[v] == -1) live++;
+                }
+                degree[u].store(live, std::memory_order_relaxed);
+            }
+        });
+
+        // degree-one vertices first, then the greedy rule for the rest;
+        // both passes keep draining the degree-one vertices they create
+        for (int pass = 0; pass < 2; pass++) {
+            parallelChunks(threads, n, [&](unsigned w, size_t begin, size_t end) {
+                for (size_t u = begin; u < end; u++) {
+                    int v = static_cast<int>(u);
+                    if (isFree(v) && (pass == 1 || degree[v].load(std::memory_order_relaxed) == 1)) {
+                        Worker self = worker(w);
+                        process(v, self);
+                    }
+                }
+            });
+            counters.round();
+        }
+        if (threads > 1) {
+            Worker self = worker(0);
+            for (int u = 0; u < n; u++) {
+                if (isFree(u)) process(u, self);
+            }
+            counters.round();
+        }
+        for (const Counters& tally : tallies) counters.merge(tally);
+    }
+};
+
+// Hopcroft-Karp phases run on several threads. The layers come from a
+// level-synchronous parallel BFS. The workers then take the free left
+// vertices as roots and run layered DFS searches. Each search claims every
+// matched pair it enters (and the free vertex it ends on) with a
+// compare-and-swap on a round stamp, so the paths found in one round are
+// vertex disjoint. The mate array stays read-only while the searches run,
+// and all paths of a round are flipped together afterwards.
+//
+// Every phase still ends with a maximal set of disjoint shortest paths. A
+// search that fails only because another search held one of its vertices
+// is retried in the next round. A round that makes no progress is rerun on
+// a single worker, where no such conflicts arise.
+//
+// side[v] is 0 for left and 1 for right vertices, as in HopcroftKarpMatcher.
+template <typename Graph, typename Counters = NoCounters>
+class ParallelHopcroftKarpMatcher {
+private:
+    const Graph& graph;
+    int n;
+    const std::vector<int8_t>& side;
+    std::vector<int>& match;
+    unsigned threads;
+
+    std::unique_ptr<std::atomic<uint32_t>[]> claimed;   // round owning the pair keyed by min(v, mate)
+    std::unique_ptr<std::atomic<uint32_t>[]> dead;      // phase in which the vertex led nowhere
+    std::unique_ptr<std::atomic<int>[]> dist;           // BFS layer of left vertices
+    std::vector<size_t> next;                           // edge cursor, owned by the vertex's claimer
+    uint32_t round = 0, phase = 0;
+    int maxLength = INT_MAX;
+    bool cut = false;
+    StopPoll stop;
+    std::vector<int> right;                             // DirectionPolicy::rightVertices()
+    size_t rightSlots = 0;
+    DirectionPolicy policy;
+
+    struct Worker {
+        std::vector<int> stack, frontier, retry;
+        std::vector<uint8_t> blocked;       // per stack frame: hit a vertex held elsewhere
+        std::vector<std::pair<int, int>> flips;
+        int found = 0;
+        size_t slots = 0;                   // rows of its next-level vertices
+        size_t explored = 0, exploredSlots = 0;    // their right mates, and their rows
+        Counters counters;
+    };
+    std::vector<Worker> workers;
+    Counters counters;
+
+    static constexpr int INF = INT_MAX;
+
+    bool claim(int key) {
+        uint32_t seen = claimed[key].load(std::memory_order_relaxed);
+        return seen != round && claimed[key].compare_exchange_strong(seen, round, std::memory_order_acq_rel);
+    }
+
+    // DFS from a free root; a path found is queued in worker.flips.
+    // blockedOut is set when the search failed because of other searches
+    bool search(int root, Worker& worker, bool& blockedOut) {
+        if (!claim(root)) return false;
+        std::vector<int>& stack = worker.stack;
+        std::vector<uint8_t>& blocked = worker.blocked;
+        stack.assign(1, root);
+        blocked.assign(1, 0);
+        next[root] = 0;
+        worker.counters.scanVertex();
+
+        while (!stack.empty()) {
+            int u = stack.back();
+            const auto& nbrs = graph[u];
+            bool advanced = false;
+            while (next[u] < nbrs.size()) {
+                int v = nbrs[next[u]++];
+                worker.counters.scanEdges(1);
+                if (v == u) continue;
+                int w = match[v];
+                if (w == -1) {
+                    if (!claim(v)) {
+                        blocked.back() = 1;
+                        continue;
+                    }
+                    for (int x : stack) {
+                        worker.flips.emplace_back(x, static_cast<int>(graph[x][next[x] - 1]));
+                    }
+                    return true;
+                }
+                if (w == u) continue;
+                if (dist[w].load(std::memory_order_relaxed) != dist[u].load(std::memory_order_relaxed) + 1 ||
+                    dead[w].load(std::memory_order_relaxed) == phase) {
+                    continue;
+                }
+                if (!claim(std::min(v, w))) {
+                    blocked.back() = 1;
+                    continue;
+                }
+                next[w] = 0;
+                stack.push_back(w);
+                blocked.push_back(0);
+                worker.counters.scanVertex();
+                advanced = true;
+                break;
+            }
+            if (!advanced) {
+                bool wasBlocked = blocked.back();
+                stack.pop_back();
+                blocked.pop_back();
+                if (!wasBlocked) {
+                    // every way on is dead, so u is dead for the phase
+                    dead[u].store(phase, std::memory_order_relaxed);
+                } else if (!blocked.empty()) {
+                    blocked.back() = 1;
+                } else {
+                    blockedOut = true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // searches from every root, in rounds, and flips the paths found
+    int augmentRounds(std::vector<int>& roots) {
+        int total = 0;
+        bool serial = false;
+        while (!roots.empty()) {
+            round++;
+            parallelChunks(serial ? 1 : threads, roots.size(), [&](unsigned w, size_t begin, size_t end) {
+                Worker& worker = workers[w];
+                for (size_t i = begin; i < end; i++) {
+                    bool blocked = false;
+                    if (search(roots[i], worker, blocked)) {
+                        worker.found++;
+                    } else if (blocked) {
+                        worker.retry.push_back(roots[i]);
+                    }
+                }
+            }, 64);
+
+            parallelChunks(threads, workers.size(), [&](unsigned, size_t begin, size_t end) {
+                for (size_t w = begin; w < end; w++) {
+                    for (const auto& f : workers[w].flips) {
+                        match[f.first] = f.second;
+                        match[f.second] = f.first;
+                    }
+                }
+            }, 1);
+
+            int found = 0;
+            roots.clear();
+            for (Worker& worker : workers) {
+                found += worker.found;
+                roots.insert(roots.end(), worker.retry.begin(), worker.retry.end());
+                worker.found = 0;
+                worker.flips.clear();
+                worker.retry.clear();
+            }
+            total += found;
+
+            if (found == 0 && serial) break;
+            serial = found == 0;
+        }
+        return total;
+    }
+
+    // level-synchronous BFS from the free left vertices; returns the roots
+    // and whether a free right vertex is reachable. Each level goes
+    // top-down or bottom-up as policy decides; bottom-up, each right
+    // vertex is only written by the worker that scans it
+    bool buildLayers(std::vector<int>& roots) {
+        roots.clear();
+        size_t slots = 0;
+        for (int u = 0; u < n; u++) {
+            bool root = side[u] == 0 && match[u] == -1;
+            dist[u].store(root ? 0 : INF, std::memory_order_relaxed);
+            if (root) {
+                roots.push_back(u);
+                slots += graph[u].size();
+            }
+        }
+
+        std::atomic<bool> reached{false};
+        std::vector<int> frontier = roots;
+        policy.reset(right.size(), rightSlots);
+        for (int depth = 0; !frontier.empty() && !reached.load(); depth++) {
+            if (depth > (maxLength - 1) / 2) {
+                cut = true;
+                break;
+            }
+            bool bottomUp = policy.bottomUp(slots);
+            counters.level(phase, static_cast<uint32_t>(depth), bottomUp);
+            auto label = [&](Worker& worker, int v, int x) {
+                worker.frontier.push_back(x);
+                worker.explored++;
+                worker.exploredSlots += graph[v].size();
+                worker.slots += graph[x].size();
+            };
+            if (bottomUp) {
+                parallelChunks(threads, right.size(), [&](unsigned w, size_t begin, size_t end) {
+                    Worker& worker = workers[w];
+                    for (size_t i = begin; i < end; i++) {
+                        int v = right[i];
+                        int x = match[v];
+                        if (x != -1 && dist[x].load(std::memory_order_relaxed) != INF) continue;
+                        worker.counters.scanVertex();
+                        const auto& nbrs = graph[v];
+                        size_t k = 0;
+                        while (k < nbrs.size() && dist[nbrs[k]].load(std::memory_order_relaxed) != depth) k++;
+                        worker.counters.scanEdges(std::min(k + 1, nbrs.size()));
+                        if (k == nbrs.size()) continue;
+                        if (x == -1) {
+                            reached.store(true, std::memory_order_relaxed);
+                        } else {
+                            dist[x].store(depth + 1, std::memory_order_relaxed);
+                            label(worker, v, x);
+                        }
+                    }
+                });
+            } else {
+                parallelChunks(threads, frontier.size(), [&](unsigned w, size_t begin, size_t end) {
+                    Worker& worker = workers[w];
+                    for (size_t i = begin; i < end; i++) {
+                        worker.counters.scanVertex();
+                        worker.counters.scanEdges(graph[frontier[i]].size());
+                        for (int v : graph[frontier[i]]) {
+                            int x = match[v];
+                            int unset = INF;
+                            if (x == -1) {
+                                reached.store(true, std::memory_order_relaxed);
+                            } else if (dist[x].load(std::memory_order_relaxed) == INF &&
+                                       dist[x].compare_exchange_strong(unset, depth + 1, std::memory_order_relaxed)) {
+                                label(worker, v, x);
+                            }
+                        }
+                    }
+                }, 256);
+            }
+            frontier.clear();
+            slots = 0;
+            for (Worker& worker : workers) {
+                frontier.insert(frontier.end(), worker.frontier.begin(), worker.frontier.end());
+                policy.explore(worker.exploredSlots, worker.explored);
+                slots += worker.slots;
+                worker.frontier.clear();
+                worker.slots = worker.explored = worker.exploredSlots = 0;
+            }
+        }
+        return reached.load();
+    }
+
+public:
+    ParallelHopcroftKarpMatcher(const Graph& graph, int n, const std::vector<int8_t>& side,
+                                std::vector<int>& match, unsigned threads)
+        : graph(graph), n(n), side(side), match(match), threads(resolveThreads(threads)),
+          claimed(new std::atomic<uint32_t>[n]), dead(new std::atomic<uint32_t>[n]),
+          dist(new std::atomic<int>[n]), next(n), workers(this->threads) {
+        for (int v = 0; v < n; v++) {
+            claimed[v].store(0, std::memory_order_relaxed);
+            dead[v].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    const Counters& work() const { return counters; }
+
+    size_t memoryBytes() const {
+        size_t bytes = static_cast<size_t>(n) * (2 * sizeof(std::atomic<uint32_t>) + sizeof(std::atomic<int>) + sizeof(size_t)) +
+                       right.capacity() * sizeof(int);
+        for (const Worker& worker : workers) {
+            bytes += (worker.stack.capacity() + worker.frontier.capacity() + worker.retry.capacity()) * sizeof(int) +
+                     worker.blocked.capacity() + worker.flips.capacity() * sizeof(std::pair<int, int>);
+        }
+        return bytes;
+    }
+
+    // the same as HopcroftKarpMatcher::setMaxPathLength()
+    void setMaxPathLength(int length) { maxLength = length; }
+    bool stoppedShort() const { return cut; }
+
+    // as HopcroftKarpMatcher::setStopSignal(), but polled before each
+    // phase only, a phase being spread over all threads
+    void setStopSignal(const StopSignal* signal) { stop = {signal}; }
+    bool interrupted() const { return stop.seen; }
+
+    // extends match to a maximum matching, returns the number of augmentations
+    int run() {
+        int augmentations = 0;
+        cut = false;
+        std::vector<int> roots;
+        rightSlots = DirectionPolicy::rightVertices(graph, n, side, right);
+        for (phase++; !stop.now() && buildLayers(roots); phase++) {
+            counters.round();
+            augmentations += augmentRounds(roots);
+        }
+        for (Worker& worker : workers) {
+            counters.merge(worker.counters);
+            worker.counters = Counters();
+        }
+        return augmentations;
+    }
+};
+
+// Degree-1 and degree-2 reductions in front of the matching engine, the
+// Karp-Sipser rules made exact. A vertex with one neighbour is matched to
+// it. A vertex v with two neighbours u and w is folded: v is dropped and u
+// and w become one vertex, since some maximum matching covers v and it
+// then has exactly one more edge than a maximum matching of the folded
+// graph. Vertices come off a bucket queue, degree one first, until every
+// vertex left has degree three or more; that kernel goes to the engine,
+// and lift() turns its matching back into one of the whole graph.
+//
+// A folded vertex is a union-find set of input vertices whose rows are
+// read together through a member list; the smaller set is always merged
+// into the larger. Degrees count adjacency slots, so parallel edges left
+// by a fold count more than once and may keep a vertex out of the queue.
+// Each fold keeps the input edges from v to u and to w, and lift() undoes
+// the folds newest first: v is matched to whichever of u and w the folded
+// vertex did not use.
+template <typename Graph, typename Counters = NoCounters>
+class MatchingReducer {
+private:
+    const Graph& graph;
+    int n;
+    std::vector<int>& match;
+    ReductionScratch buffers;
+    ReductionScratch* scratch;
+    Counters counters;
+    int degreeOne = 0;
+
+    enum : uint8_t { Live, Matched, Dropped };
+
+    int find(int v) {
+        std::vector<int>& owner = buffers.owner;
+        while (owner[v] != v) {
+            owner[v] = owner[owner[v]];
+            v = owner[v];
+        }
+        return v;
+    }
+
+    void push(int r) {
+        if (buffers.degree[r] <= 1) {
+            buffers.ones.push_back(r);
+        } else if (buffers.degree[r] == 2) {
+            buffers.twos.push_back(r);
+        }
+    }
+
+    // the first live slots of r, at most two of them, as input edges
+    int liveSlots(int r, Edge* found) {
+        int count = 0;
+        for (int p = r; p != -1 && count < 2; p = buffers.nextMember[p]) {
+            counters.scanEdges(graph[p].size());
+            for (int q : graph[p]) {
+                int x = find(q);
+                if (x != r && buffers.state[x] == Live) {
+                    found[count++] = Edge(p, q);
+                    if (count == 2) break;
+                }
+            }
+        }
+        return count;
+    }
+
+    // r leaves the graph: its live neighbours lose the slots to it
+    void retire(int r, uint8_t state) {
+        buffers.state[r] = state;
+        counters.scanVertex();
+        for (int p = r; p != -1; p = buffers.nextMember[p]) {
+            counters.scanEdges(graph[p].size());
+            for (int q : graph[p]) {
+                int x = find(q);
+                if (x != r && buffers.state[x] == Live) {
+                    buffers.degree[x]--;
+                    push(x);
+                }
+            }
+        }
+    }
+
+    void pair(const Edge& e) {
+        int r = find(e.u), x = find(e.v);
+        match[e.u] = e.v;
+        match[e.v] = e.u;
+        buffers.carrier[r] = e.u;
+        buffers.carrier[x] = e.v;
+        retire(r, Matched);
+        retire(x, Matched);
+        degreeOne++;
+    }
+
+    // merges the sets of u and w once the vertex between them is gone
+    void merge(int u, int w, const Edge& toU, const Edge& toW, int v) {
+        std::vector<int>& nextMember = buffers.nextMember;
+        int kept = buffers.slots[u] >= buffers.slots[w] ? u : w;
+        int absorbed = kept == u ? w : u;
+        int shared = 0;   // slots between u and w, inside the merged set
+        for (int p = absorbed; p != -1; p = nextMember[p]) {
+            counters.scanEdges(graph[p].size());
+            for (int q : graph[p]) {
+                if (find(q) == kept) shared++;
+            }
+        }
+        buffers.folds.push_back({v, u, w, kept, absorbed, buffers.lastMember[kept], buffers.lastMember[absorbed], toU, toW});
+        buffers.owner[absorbed] = kept;
+        nextMember[buffers.lastMember[kept]] = absorbed;
+        buffers.lastMember[kept] = buffers.lastMember[absorbed];
+        buffers.slots[kept] += buffers.slots[absorbed];
+        buffers.degree[kept] += buffers.degree[absorbed] - 2 * shared;
+        push(kept);
+    }
+
+    // the input edge behind a kernel edge between the sets r and x
+    Edge slotBetween(int r, int x) {
+        for (int p = r; p != -1; p = buffers.nextMember[p]) {
+            for (int q : graph[p]) {
+                if (find(q) == x) return Edge(p, q);
+            }
+        }
+        throw std::logic_error("Kernel edge without an input edge");
+    }
+
+public:
+    MatchingReducer(const Graph& graph, int n, std::vector<int>& match, ReductionScratch* scratch = nullptr)
+        : graph(graph), n(n), match(match), scratch(scratch) {
+        if (scratch) std::swap(buffers, *scratch);
+    }
+
+    ~MatchingReducer() {
+        if (scratch) std::swap(buffers, *scratch);
+    }
+
+    MatchingReducer(const MatchingReducer&) = delete;
+    MatchingReducer& operator=(const MatchingReducer&) = delete;
+
+    const Counters& work() const { return counters; }
+    size_t memoryBytes() const { return buffers.bytes(); }
+
+    int degreeOneMatches() const { return degreeOne; }
+    int folds() const { return static_cast<int>(buffers.folds.size()); }
+
+    // applies both rules until none is left; match gets the degree-one
+    // pairs, and must start out empty
+    void reduce() {
+        buffers.owner.resize(n);
+        buffers.nextMember.assign(n, -1);
+        buffers.lastMember.resize(n);
+        buffers.slots.resize(n);
+        buffers.degree.resize(n);
+        buffers.state.assign(n, Live);
+        buffers.carrier.assign(n, -1);
+        buffers.ones.clear();
+        buffers.twos.clear();
+        buffers.folds.clear();
+        degreeOne = 0;
+        for (int v = 0; v < n; v++) {
+            buffers.owner[v] = v;
+            buffers.lastMember[v] = v;
+            buffers.slots[v] = static_cast<uint32_t>(graph[v].size());
+            int live = 0;
+            for (int q : graph[v]) {
+                if (q != v) live++;
+            }
+            buffers.degree[v] = live;
+            push(v);
+        }
+
+        Edge found[2];
+        while (!buffers.ones.empty() || !buffers.twos.empty()) {
+            std::vector<int>& queue = buffers.ones.empty() ? buffers.twos : buffers.ones;
+            int v = queue.back();
+            queue.pop_back();
+            if (buffers.owner[v] != v || buffers.state[v] != Live || buffers.degree[v] > 2) continue;
+
+            int count = liveSlots(v, found);
+            if (count == 0) {
+                retire(v, Dropped);
+                continue;
+            }
+            int u = find(found[0].v);
+            int w = count == 2 ? find(found[1].v) : u;
+            if (u == w) {
+                pair(found[0]);
+            } else {
+                retire(v, Dropped);
+                merge(u, w, found[0], found[1], v);
+            }
+        }
+    }
+
+    // The vertices left after reduce(), renumbered from 0 into the edge
+    // list of the kernel graph. Returns their count
+    int kernel(std::vector<Edge>& edges) {
+        std::vector<int>& vertices = buffers.kernel;
+        std::vector<int>& local = buffers.lastMember;   // not needed after reduce()
+        vertices.clear();
+        for (int v = 0; v < n; v++) {
+            if (buffers.owner[v] == v && buffers.state[v] == Live) {
+                local[v] = static_cast<int>(vertices.size());
+                vertices.push_back(v);
+            }
+        }
+        edges.clear();
+        for (int r : vertices) {
+            for (int p = r; p != -1; p = buffers.nextMember[p]) {
+                for (int q : graph[p]) {
+                    int x = find(q);
+                    if (x != r && buffers.state[x] == Live && local[r] < local[x]) {
+                        edges.push_back(Edge(local[r], local[x]));
+                    }
+                }
+            }
+        }
+        return static_cast<int>(vertices.size());
+    }
+
+    // kernelMatch is a matching of the kernel() graph; writes the matching
+    // of the whole graph it stands for into match
+    void lift(const std::vector<int>& kernelMatch) {
+        const std::vector<int>& vertices = buffers.kernel;
+        for (size_t i = 0; i < kernelMatch.size(); i++) {
+            int j = kernelMatch[i];
+            if (j == -1 || j < static_cast<int>(i)) continue;
+            Edge e = slotBetween(vertices[i], vertices[j]);
+            match[e.u] = e.v;
+            match[e.v] = e.u;
+            buffers.carrier[vertices[i]] = e.u;
+            buffers.carrier[vertices[j]] = e.v;
+        }
+
+        std::vector<int>& owner = buffers.owner;
+        std::vector<int>& carrier = buffers.carrier;
+        for (auto it = buffers.folds.rbegin(); it != buffers.folds.rend(); ++it) {
+            const ReductionScratch::Fold& f = *it;
+            // split the merged set back into the two it was made of
+            for (int p = f.absorbed;; p = buffers.nextMember[p]) {
+                owner[p] = f.absorbed;
+                if (p == f.absorbedLast) break;
+            }
+            buffers.nextMember[f.keptLast] = -1;
+
+            int used = carrier[f.kept];
+            int side = used == -1 ? -1 : find(used);
+            carrier[f.kept] = carrier[f.absorbed] = -1;
+            if (side != -1) carrier[side] = used;
+            const Edge& e = side == f.u ? f.toW : f.toU;
+            match[e.u] = e.v;
+            match[e.v] = e.u;
+            carrier[f.v] = e.u;
+            carrier[side == f.u ? f.w : f.u] = e.v;
+        }
+    }
+};
+
+// The vertex orders of SolverOptions::reorder, as order[new id] = old id.
+// Degree is a counting sort; BFS and reverse Cuthill-McKee start each
+// component at its lowest vertex, RCM at one of its lowest degree (taken
+// from a counting sort by degree), and RCM queues the neighbours it
+// discovers by degree ascending. All are O(V + E) but RCM, which sorts
+// each batch of discovered neighbours.
+struct VertexReordering {
+    template <typename Graph>
+    static void order(const Graph& g, VertexOrder kind, std::vector<int>& order) {
+        int n = static_cast<int>(g.n);
+        order.clear();
+        order.reserve(n);
+        if (kind == VertexOrder::Input) {
+            for (int v = 0; v < n; v++) order.push_back(v);
+            return;
+        }
+        if (kind == VertexOrder::Degree) {
+            byDegree(g, order);
+            std::reverse(order.begin(), order.end());
+            return;
+        }
+
+        std::vector<int> starts;
+        if (kind == VertexOrder::ReverseCuthillMcKee) {
+            byDegree(g, starts);
+        } else {
+            for (int v = 0; v < n; v++) starts.push_back(v);
+        }
+        std::vector<uint8_t> seen(n, 0);
+        for (int s : starts) {
+            if (seen[s]) continue;
+            seen[s] = 1;
+            order.push_back(s);
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                size_t found = order.size();
+                for (uint32_t w : g[static_cast<uint32_t>(order[head])]) {
+                    if (!seen[w]) {
+                        seen[w] = 1;
+                        order.push_back(static_cast<int>(w));
+                    }
+                }
+                if (kind == VertexOrder::ReverseCuthillMcKee) {
+                    std::sort(order.begin() + found, order.end(), [&](int a, int b) {
+                        return g.degree(a) != g.degree(b) ? g.degree(a) < g.degree(b) : a < b;
+                    });
+                }
+            }
+        }
+        if (kind == VertexOrder::ReverseCuthillMcKee) std::reverse(order.begin(), order.end());
+    }
+
+    // g with vertex order[i] renamed i: rows are copied in the new order
+    // and their entries mapped through rank, the inverse of order, in one
+    // sequential pass over the new arrays
+    template <typename Index, typename Offset>
+    static BasicCSRGraph<Index, Offset> relabel(const BasicCSRView<Index, Offset>& g, const std::vector<int>& order,
+                                                std::vector<int>& rank) {
+        uint32_t n = g.n;
+        rank.resize(n);
+        for (uint32_t i = 0; i < n; i++) {
+            rank[order[i]] = static_cast<int>(i);
+        }
+        BasicCSRGraph<Index, Offset> copy;
+        copy.n = n;
+        copy.offsets.resize(static_cast<size_t>(n) + 1);
+        copy.offsets[0] = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            copy.offsets[i + 1] = copy.offsets[i] + static_cast<Offset>(g.degree(order[i]));
+        }
+        copy.neighbors.resize(g.offsets[n]);
+        Index* out = copy.neighbors.data();
+        for (uint32_t i = 0; i < n; i++) {
+            for (uint32_t w : g[static_cast<uint32_t>(order[i])]) {
+                *out++ = static_cast<Index>(rank[w]);
+            }
+        }
+        return copy;
+    }
+
+private:
+    // vertices by degree ascending, ties by id
+    template <typename Graph>
+    static void byDegree(const Graph& g, std::vector<int>& order) {
+        size_t top = 0;
+        for (uint32_t v = 0; v < g.n; v++) {
+            top = std::max(top, g.degree(v));
+        }
+        std::vector<int> start(top + 2, 0);
+        for (uint32_t v = 0; v < g.n; v++) {
+            start[g.degree(v) + 1]++;
+        }
+        for (size_t d = 1; d < start.size(); d++) {
+            start[d] += start[d - 1];
+        }
+        order.resize(g.n);
+        for (uint32_t v = 0; v < g.n; v++) {
+            order[start[g.degree(v)]++] = static_cast<int>(v);
+        }
+    }
+};
+
+// Minimum edge cover solver over CSR arrays of Index-wide vertex ids and
+// Offset-wide slots. Every engine is instantiated on that exact view, so
+// the hot loops read the caller's widths with no conversion or dispatch.
+// MinEdgeCover, 32-bit both, is the default; CompactMinEdgeCover halves
+// the neighbour array of graphs up to 65536 vertices, and WideMinEdgeCover
+// takes graphs of more than 2^31 edges. Mates stay int either way.
+template <typename Index = uint32_t, typename Offset = uint32_t>
+class BasicMinEdgeCover {
+public:
+    using View = BasicCSRView<Index, Offset>;
+    using Storage = BasicCSRGraph<Index, Offset>;
+
 private:
     int n;
-    std::vector<Edge> edges;
-    std::vector<std::vector<int>> adj;
+    Storage storage;              // empty when the solver reads caller-owned arrays
+    View graph;                   // what every stage reads, usually storage.view()
+    SolverOptions options;
+    std::vector<int8_t> side;     // 2-colouring, valid when bipartite; 1 on tree components
+    bool bipartite = false;
+    std::vector<int> treeOrder;   // BFS order of the tree components, roots first
+    std::vector<int> match;       // mate array, -1 for exposed vertices
+    int gap = 0;                  // bound on maximum - |match| after the last solve
+    bool interrupted = false;     // options.stop ended the last solve early
+
+    // A connected component with a cycle, as a range of cyclicOrder, or a
+    // run of count small ones of the same kind that are solved together
+    struct Component {
+        int begin, size, count;
+        bool bipartite;
+    };
+    std::vector<int> cyclicOrder;          // BFS order of the other components
+    std::vector<Component> components;     // largest first; single vertices left out
+
+    // components smaller than this are merged into runs of about this many
+    // vertices, so no matchComponents() task is too small to be worth it
+    static constexpr int componentGrain = 1024;
+
+    // buffers of one solve, all on one memory resource
+    struct Workspace {
+        std::pmr::vector<int> queue, parent, tree;
+        std::pmr::vector<uint8_t> covered;
+        std::pmr::vector<uint32_t> mark;    // vertices stamped with the current epoch are visited
+        uint32_t epoch = 0;
+        std::pmr::vector<uint64_t> bits;    // matched set of denseGreedyMatching()
+        BlossomScratch blossom;
+        HopcroftKarpScratch hopcroftKarp;
+
+        explicit Workspace(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+            : queue(memory), parent(memory), tree(memory), covered(memory), mark(memory), bits(memory), blossom(memory),
+              hopcroftKarp(memory) {}
+
+        std::pmr::memory_resource* resource() const { return queue.get_allocator().resource(); }
+
+        // unmarks every vertex at once; the marks are only cleared when
+        // the vertex count changes or the stamp wraps around
+        uint32_t nextEpoch(int n) {
+            if (mark.size() != static_cast<size_t>(n) || ++epoch == 0) {
+                mark.assign(n, 0);
+                epoch = 1;
+            }
+            return epoch;
+        }
+    };
+
+    // kept between solves and across assign(), unless options.memory or
+    // options.arenaBytes ask for a fresh workspace per solve
+    Workspace workspace;
+    KarpSipserScratch warmStartScratch;
+    ReductionScratch reductionScratch;
+
+    // one solver and edge list per matchComponents() worker, kept between
+    // solves; each is assign()ed the components it takes, renumbered from 0.
+    // The first one also solves the kernel with options.reduce
+    std::vector<BasicMinEdgeCover> componentSolvers;
+    std::vector<std::vector<Edge>> componentEdges;
+
+    // options.reorder: order[new id] = old id, and its inverse. The first
+    // sub-solver holds the relabelled graph from the first solve until the
+    // graph changes
+    std::vector<int> vertexOrder, vertexRank;
+    bool reordered = false;
+
+    // mate array given to warmStartFrom() for the next solve, empty when
+    // none, and what the seeded solve made of its pairs
+    std::vector<int> seed;
+    int seedKept = 0, seedDropped = 0, seedUnpaired = 0;
+
+    // bit rows of a graph at least options.denseThreshold dense, built by
+    // the first solve that needs them and kept until the graph changes
+    BitMatrix dense;
+
+    bool isDense() const {
+        double pairs = static_cast<double>(n) * n;
+        return n > 0 && options.denseThreshold > 0 && graph.offsets[n] >= options.denseThreshold * pairs;
+    }
+
+    const BitMatrix* denseRows() {
+        if (!isDense()) return nullptr;
+        if (dense.empty()) dense.assign(graph);
+        return &dense;
+    }
+
+    // BFS over every component: 2-colouring, and the tree test (one edge
+    // fewer than vertices). Tree components are matched by matchForest(),
+    // so their vertices all go to side 1, where the Hopcroft-Karp engines
+    // never root a search. The others are kept as ranges of cyclicOrder
+    // for matchComponents()
+    void analyzeComponents() {
+        side.assign(n, -1);
+        treeOrder.clear();
+        cyclicOrder.clear();
+        components.clear();
+        bipartite = true;
+        std::pmr::vector<int>& queue = workspace.queue;
+        queue.reserve(n);
+        for (int s = 0; s < n; s++) {
+            if (side[s] != -1) continue;
+            side[s] = 0;
+            queue.clear();
+            queue.push_back(s);
+            size_t slots = 0;
+            bool twoColoured = true;
+            for (size_t head = 0; head < queue.size(); head++) {
+                int u = queue[head];
+                slots += graph[u].size();
+                for (int v : graph[u]) {
+                    if (side[v] == -1) {
+                        side[v] = side[u] ^ 1;
+                        queue.push_back(v);
+                    } else if (side[v] == side[u]) {
+                        twoColoured = false;
+                    }
+                }
+            }
+            bipartite = bipartite && twoColoured;
+            if (slots / 2 + 1 == queue.size()) {
+                treeOrder.insert(treeOrder.end(), queue.begin(), queue.end());
+                for (int v : queue) side[v] = 1;
+            } else if (queue.size() > 1) {
+                // a lone vertex with only self-loops has nothing to match
+                components.push_back({static_cast<int>(cyclicOrder.size()), static_cast<int>(queue.size()), 1, twoColoured});
+                cyclicOrder.insert(cyclicOrder.end(), queue.begin(), queue.end());
+            }
+        }
+        if (components.size() > 1) groupComponents();
+    }
+
+    // Sorts the components largest first, with the small ones after them
+    // grouped by kind, then rewrites cyclicOrder in that order and merges
+    // neighbouring small components of one kind into runs
+    void groupComponents() {
+        std::sort(components.begin(), components.end(), [](const Component& a, const Component& b) {
+            bool largeA = a.size >= componentGrain, largeB = b.size >= componentGrain;
+            if (largeA != largeB) return largeA;
+            if (!largeA && a.bipartite != b.bipartite) return a.bipartite;
+            return a.size > b.size;
+        });
+        std::pmr::vector<int>& sorted = workspace.parent;
+        sorted.clear();
+        size_t runs = 0;
+        for (size_t i = 0; i < components.size(); i++) {
+            Component c = components[i];
+            int begin = static_cast<int>(sorted.size());
+            sorted.insert(sorted.end(), cyclicOrder.begin() + c.begin, cyclicOrder.begin() + c.begin + c.size);
+            Component* open = runs > 0 ? &components[runs - 1] : nullptr;
+            if (c.size < componentGrain && open != nullptr && open->size < componentGrain && open->bipartite == c.bipartite) {
+                open->size += c.size;
+                open->count++;
+            } else {
+                components[runs++] = {begin, c.size, 1, c.bipartite};
+            }
+        }
+        components.resize(runs);
+        std::copy(sorted.begin(), sorted.end(), cyclicOrder.begin());
+    }
+
+    // Exact maximum matching of the tree components in O(V): leaves up, a
+    // vertex is matched to its parent when both are free. In reverse BFS
+    // order a vertex's children are passed before it, so its parent is the
+    // one neighbour not passed yet
+    template <typename Counters>
+    void matchForest(Counters& counters, Workspace& ws) {
+        if (treeOrder.empty()) return;
+        uint32_t stamp = ws.nextEpoch(n);
+        uint32_t* passed = ws.mark.data();
+        for (auto it = treeOrder.rbegin(); it != treeOrder.rend(); ++it) {
+            int v = *it;
+            passed[v] = stamp;
+            if (match[v] != -1) continue;
+            counters.scanEdges(graph[v].size());
+            for (int p : graph[v]) {
+                if (passed[p] != stamp) {
+                    if (match[p] == -1) {
+                        match[v] = p;
+                        match[p] = v;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    bool ownsGraph() const { return graph.offsets == storage.offsets.data(); }
+
+    // back to the empty graph of the default constructor
+    void clearGraph() {
+        n = 0;
+        storage.assign(0, nullptr, 0);
+        graph = storage.view();
+        bipartite = false;
+        treeOrder.clear();
+        cyclicOrder.clear();
+        components.clear();
+        match.clear();
+        dense.clear();
+        reordered = false;
+        seed.clear();
+    }
+
+    // O(V + E) structural check of a CSR graph that did not come from fromEdges()
+    static void validate(const View& g) {
+        if (g.offsets[0] != 0) {
+            throw std::invalid_argument("Malformed CSR graph");
+        }
+        for (uint32_t u = 0; u < g.n; u++) {
+            if (g.offsets[u + 1] < g.offsets[u]) {
+                throw std::invalid_argument("Malformed CSR graph");
+            }
+        }
+        for (Offset i = 0; i < g.offsets[g.n]; i++) {
+            if (g.neighbors[i] >= g.n) {
+                throw std::invalid_argument("Invalid vertex index");
+            }
+        }
+    }
+
+    // validation and analysis shared by the constructors
+    void init() {
+        // check for isolated vertices
+        for (int i = 0; i < n; i++) {
+            if (graph.degree(i) == 0) {
+                throw std::invalid_argument("Graph contains isolated vertices - edge cover impossible");
+            }
+        }
+
+        analyzeComponents();
+        if (options.engine == MatchingEngine::HopcroftKarp && !bipartite) {
+            throw std::invalid_argument("Hopcroft-Karp engine requires a bipartite graph");
+        }
+    }
+
+    // adds one incident edge for every vertex the matching leaves exposed.
+    // Each exposed vertex only reads its own CSR row, so the pass is O(V + E);
+    // an exposed neighbour is preferred so one edge covers both ends
+    void completeCover(std::vector<Edge>& cover, Workspace& ws) {
+        std::pmr::vector<uint8_t>& covered = ws.covered;
+        covered.assign(n, 0);
+        for (const auto& e : cover) {
+            covered[e.u] = 1;
+            covered[e.v] = 1;
+        }
+
+        for (int i = 0; i < n; i++) {
+            if (covered[i]) continue;
+            int pick = graph[i][0];
+            for (int v : graph[i]) {
+                if (!covered[v]) {
+                    pick = v;
+                    break;
+                }
+            }
+            cover.push_back(Edge(i, pick));
+            covered[i] = 1;
+            covered[pick] = 1;
+        }
+    }
+
+    MatchingEngine resolveEngine() const {
+        if (options.engine == MatchingEngine::Auto) {
+            return bipartite ? MatchingEngine::HopcroftKarp : MatchingEngine::Blossom;
+        }
+        return options.engine;
+    }
+
+    // true when (u, v) is an edge, from the shorter of the two rows
+    bool adjacent(int u, int v) const {
+        if (graph.degree(v) < graph.degree(u)) std::swap(u, v);
+        for (int w : graph[u]) {
+            if (w == v) return true;
+        }
+        return false;
+    }
 
-    // find maximum matching
-    std::vector<Edge> findMaxMatching() {
-        std::vector<int> match(n, -1);
-        std::vector<Edge> matching;
+    // The warm start from seed: its pairs that are edges of this graph,
+    // between vertices still free, then the greedy rule for the rest, so
+    // the matching is maximal. O(V + E); the seed is used up
+    template <typename Counters>
+    void seededMatching(Counters& counters) {
+        seedKept = seedDropped = 0;
+        for (int v = 0; v < n; v++) {
+            int m = seed[v];
+            if (m == -1 || (m < v && m >= 0 && seed[m] == v)) continue;
+            if (v < m && m < n && seed[m] == v && match[v] == -1 && match[m] == -1) {
+                counters.scanEdges(std::min(graph.degree(v), graph.degree(m)));
+                if (adjacent(v, m)) {
+                    match[v] = m;
+                    match[m] = v;
+                    seedKept++;
+                    continue;
+                }
+            }
+            seedDropped++;
+        }
+        seed.clear();
+        greedyMatching(counters);
+    }
 
-        // greedy algorithm for initial matching
-        std::vector<bool> used(n, false);
-        for (const auto& e : edges) {
-            if (!used[e.u] && !used[e.v]) {
-                match[e.u] = e.v;
-                match[e.v] = e.u;
-                used[e.u] = used[e.v] = true;
-                matching.push_back(e);
+    // fast approximate mode, first half: greedy algorithm for initial
+    // matching; starts from an empty mate array
+    template <typename Counters>
+    void greedyMatching(Counters& counters) {
+        for (int u = 0; u < n; u++) {
+            counters.scanEdges(graph[u].size());
+            for (int v : graph[u]) {
+                if (u < v && match[u] == -1 && match[v] == -1) {
+                    match[u] = v;
+                    match[v] = u;
+                }
             }
         }
+    }
+
+    // Warm start of the exact engines on dense graphs, in place of
+    // Karp-Sipser, which would pay a degree update per edge for a degree-1
+    // rule that hardly ever fires there: each exposed vertex takes the
+    // first neighbour of its bit row that is not yet matched
+    template <typename Counters>
+    void denseGreedyMatching(const BitMatrix& rows, Counters& counters, Workspace& ws) {
+        BitMatrix::resetMask(ws.bits, n);
+        uint64_t* matched = ws.bits.data();
+        for (int u = 0; u < n; u++) {
+            if (match[u] != -1) BitMatrix::setBit(matched, u);
+        }
+        for (int u = 0; u < n; u++) {
+            if (match[u] != -1) continue;
+            // u is taken off the free set even when it stays exposed: every
+            // later vertex next to it is then already matched
+            BitMatrix::setBit(matched, u);
+            counters.scanEdges(rows.words);
+            BitMatrix::forEachAndNot(rows.row(u), matched, matched, rows.words, [&](int v) {
+                match[u] = v;
+                match[v] = u;
+                BitMatrix::setBit(matched, v);
+                return true;
+            });
+        }
+    }
 
-        // improvement using augmenting paths
+    // second half: improvement by multi-source BFS, returns the number of
+    // improvements. Every exposed vertex roots an alternating tree: its
+    // outer vertices are the root and the mates of the inner ones, and only
+    // outer vertices are expanded. An edge between outer vertices of two
+    // trees closes an augmenting path through both roots; it is flipped,
+    // and both trees are spent for the round, so one round applies many
+    // disjoint paths. Rounds repeat until one finds none, or until
+    // options.stop, which is polled between expansions. Blossoms are not
+    // contracted, so paths through an odd cycle are missed. Each round
+    // reuses one flat queue and starts a new mark epoch instead of clearing
+    // anything, so a round costs only what it visits plus the scan for
+    // exposed roots
+    template <typename Counters>
+    int improveMatching(Counters& counters, Workspace& ws) {
+        int augmentations = 0;
         bool improved = true;
-        while (improved) {
+        std::pmr::vector<int>& parent = ws.parent;
+        std::pmr::vector<int>& tree = ws.tree;
+        std::pmr::vector<int>& queue = ws.queue;
+        parent.resize(n);
+        tree.resize(n);
+        queue.reserve(n);
+        StopPoll stop{options.stop};
+
+        // tree[v] is the root of v's tree, and tree[root] is -1 - root once
+        // the tree is spent; owner() is -1 for a spent tree
+        auto owner = [&](int v) {
+            int root = tree[v];
+            return root < 0 || tree[root] < 0 ? -1 : root;
+        };
+        // v's mate is parent[v], or v is a root, exactly on outer vertices
+        auto outer = [&](int v) { return parent[v] == -1 || parent[v] == match[v]; };
+        // matches the outer vertex x to p and shifts the tree path above x
+        auto flip = [&](int x, int p) {
+            for (;;) {
+                int v = match[x];
+                match[x] = p;
+                if (v == -1) return;
+                int w = parent[v];
+                match[v] = w;
+                p = v;
+                x = w;
+            }
+        };
+
+        while (improved && !interrupted) {
+            if (stop.now()) {
+                interrupted = true;
+                break;
+            }
+            counters.round();
             improved = false;
-            std::vector<int> parent(n, -1);
-            std::vector<bool> visited(n, false);
-            std::queue<int> q;
+            uint32_t stamp = ws.nextEpoch(n);
+            uint32_t* mark = ws.mark.data();
+            queue.clear();
 
             // find unmatched vertices
             for (int i = 0; i < n; i++) {
                 if (match[i] == -1) {
-                    q.push(i);
-                    visited[i] = true;
+                    queue.push_back(i);
+                    mark[i] = stamp;
+                    parent[i] = -1;
+                    tree[i] = i;
                 }
             }
 
-            int pathEnd = -1;
-            while (!q.empty() && pathEnd == -1) {
-                int u = q.front();
-                q.pop();
+            for (size_t head = 0; head < queue.size(); head++) {
+                if (stop.due()) {
+                    interrupted = true;
+                    break;
+                }
+                int u = queue[head];
+                int root = owner(u);
+                if (root == -1) continue;
+                counters.scanVertex();
+                counters.scanEdges(graph[u].size());
 
-                for (int v : adj[u]) {
-                    if (!visited[v]) {
-                        visited[v] = true;
+                for (int v : graph[u]) {
+                    if (mark[v] != stamp) {
+                        // every exposed vertex is a root, so v is matched
+                        int w = match[v];
+                        mark[v] = mark[w] = stamp;
                         parent[v] = u;
-
-                        if (match[v] == -1) {
-                            pathEnd = v;
-                            break;
-                        } else {
-                            q.push(match[v]);
-                            visited[match[v]] = true;
-                            parent[match[v]] = v;
-                        }
+                        parent[w] = v;
+                        tree[v] = tree[w] = root;
+                        queue.push_back(w);
+                        continue;
                     }
+                    int other = owner(v);
+                    if (other == -1 || other == root || !outer(v)) continue;
+
+                    // augmenting path found, flip it in the mate array
+                    flip(u, v);
+                    flip(v, u);
+                    tree[root] = -1 - root;
+                    tree[other] = -1 - other;
+                    improved = true;
+                    augmentations++;
+                    break;
                 }
             }
+        }
+        return augmentations;
+    }
 
-            if (pathEnd != -1) {
-                // augmenting path found
-                improved = true;
-                int v = pathEnd;
-                while (parent[v] != -1) {
-                    int u = parent[v];
-                    int prev = parent[u];
-                    match[v] = u;
-                    match[u] = v;
-                    v = prev;
-                }
+    // adds an engine's counters and workspace to the statistics
+    template <typename Engine>
+    static void collect(const Engine& engine, SolveStats* stats) {
+        stats->work.merge(engine.work());
+        stats->workspaceBytes = std::max(stats->workspaceBytes, engine.memoryBytes());
+    }
 
-                // rebuild matching
-                matching.clear();
-                for (int i = 0; i < n; i++) {
-                    if (match[i] != -1 && i < match[i]) {
-                        matching.push_back(Edge(i, match[i]));
-                    }
-                }
+    // How many edges a maximum matching may have over the current one,
+    // when no augmenting path is shorter than shortest edges: the
+    // symmetric difference with a maximum matching holds one disjoint
+    // augmenting path per missing edge, each through (shortest - 1) / 2
+    // matched edges, and two exposed vertices; on a bipartite graph one
+    // on each side. Below 3 (a matching not known to be maximal) only the
+    // exposed vertices bound it
+    int gapWithin(int shortest) const {
+        int exposed[2] = {0, 0};
+        for (int v = 0; v < n; v++) {
+            if (match[v] == -1) exposed[bipartite ? side[v] : 0]++;
+        }
+        int free = bipartite ? std::min(exposed[0], exposed[1]) : (exposed[0] / 2);
+        int matched = (n - exposed[0] - exposed[1]) / 2;
+        if (shortest < 3) return free;
+        return std::min(matched / ((shortest - 1) / 2), free);
+    }
+
+    // runs the exact engine (or the BFS improvement) on the warm start
+    // and sets gap
+    template <bool Collect, typename Counters>
+    int augment(MatchingEngine engine, unsigned threads, Counters& counters, SolveStats* stats, Workspace& ws) {
+        if (engine == MatchingEngine::Greedy) {
+            // the greedy matching is maximal, so no path is a single edge
+            int augmentations = improveMatching(counters, ws);
+            gap = gapWithin(3);
+            return augmentations;
+        }
+        // a stopped Hopcroft-Karp run knows only that the warm start, and
+        // so the matching, is maximal: every warm start ends maximal (the
+        // parallel Karp-Sipser one after its sequential pass), and
+        // augmenting keeps every matched vertex matched
+        int augmentations;
+        int length = augmentingPathLimit(options.epsilon);
+        if (engine == MatchingEngine::HopcroftKarp && threads > 1) {
+            ParallelHopcroftKarpMatcher<View, Counters> matcher(graph, n, side, match, threads);
+            matcher.setMaxPathLength(length);
+            matcher.setStopSignal(options.stop);
+            augmentations = matcher.run();
+            interrupted = matcher.interrupted();
+            if (interrupted) {
+                gap = gapWithin(3);
+            } else if (matcher.stoppedShort()) {
+                gap = gapWithin(length + 2);
+            }
+            if constexpr (Collect) collect(matcher, stats);
+        } else if (engine == MatchingEngine::HopcroftKarp) {
+            HopcroftKarpMatcher<View, Counters> matcher(graph, n, side, match, &ws.hopcroftKarp);
+            matcher.useBitRows(denseRows());
+            matcher.setMaxPathLength(length);
+            matcher.setStopSignal(options.stop);
+            augmentations = matcher.run();
+            interrupted = matcher.interrupted();
+            if (interrupted) {
+                gap = gapWithin(3);
+            } else if (matcher.stoppedShort()) {
+                gap = gapWithin(length + 2);
+            }
+            if constexpr (Collect) collect(matcher, stats);
+        } else {
+            BlossomMatcher<View, Counters> matcher(graph, n, match, &ws.blossom);
+            matcher.useBitRows(denseRows());
+            for (int v : treeOrder) matcher.exclude(v);
+            matcher.setMaxPathLength(length);
+            matcher.setStopSignal(options.stop);
+            augmentations = matcher.run();
+            interrupted = matcher.interrupted();
+            gap = matcher.openRoots() / 2;
+            if constexpr (Collect) collect(matcher, stats);
+        }
+        return augmentations;
+    }
+
+    // the engine that solves component c as a graph of its own
+    MatchingEngine engineFor(const Component& c) const {
+        if (options.engine == MatchingEngine::Auto) {
+            return c.bipartite ? MatchingEngine::HopcroftKarp : MatchingEngine::Blossom;
+        }
+        return options.engine;
+    }
+
+    // Several cyclic components are solved one by one when there are
+    // threads to spread them over, or, under Auto, when some of them are
+    // bipartite and would otherwise go to the blossom engine with the rest
+    bool splitComponents(unsigned threads) const {
+        if (components.size() < 2) return false;
+        if (threads > 1) return true;
+        if (options.engine != MatchingEngine::Auto || bipartite) return false;
+        return std::any_of(components.begin(), components.end(), [](const Component& c) { return c.bipartite; });
+    }
+
+    // adds the statistics of one component's matching to the total
+    static void accumulate(SolveStats& total, const SolveStats& part) {
+        total.warmStartTime += part.warmStartTime;
+        total.augmentTime += part.augmentTime;
+        total.initialMatchingSize += part.initialMatchingSize;
+        total.augmentations += part.augmentations;
+        total.work.merge(part.work);
+        total.workspaceBytes = std::max(total.workspaceBytes, part.workspaceBytes);
+    }
+
+    // Copies component c (or a run of them) into solver as a graph of its
+    // own, numbered by position in cyclicOrder, matches it and writes the
+    // mates back. local maps a vertex to that number; components share no
+    // vertex, so workers fill it at once
+    template <bool Collect>
+    int solveComponent(const Component& c, BasicMinEdgeCover& solver, Workspace* space, std::vector<Edge>& edges,
+                       int* local, SolveStats* stats, std::atomic<int>& gaps, std::atomic<bool>& stopped) {
+        const int* order = cyclicOrder.data() + c.begin;
+        for (int i = 0; i < c.size; i++) {
+            local[order[i]] = i;
+        }
+        edges.clear();
+        for (int i = 0; i < c.size; i++) {
+            for (int w : graph[order[i]]) {
+                if (i < local[w]) edges.push_back(Edge(i, local[w]));
+            }
+        }
+        solver.assign(c.size, edges);
+
+        SolveStats part;
+        int augmentations = solver.withWorkspaceOn(space, [&](Workspace& ws) {
+            return solver.findMaxMatching<Collect>(solver.resolveEngine(), &part, ws);
+        });
+        if constexpr (Collect) accumulate(*stats, part);
+        gaps.fetch_add(solver.gap, std::memory_order_relaxed);
+        if (solver.interrupted) stopped.store(true, std::memory_order_relaxed);
+        for (int i = 0; i < c.size; i++) {
+            int mate = solver.match[i];
+            if (mate != -1) match[order[i]] = order[mate];
+        }
+        return augmentations;
+    }
+
+    // the sub-solvers run the same engine as this one, single-threaded,
+    // and obey the StopSignal of the current solve
+    void addSubSolvers(size_t count) {
+        if (componentSolvers.size() < count) {
+            SolverOptions perGraph;
+            perGraph.engine = options.engine;
+            perGraph.denseThreshold = options.denseThreshold;
+            perGraph.epsilon = options.epsilon;
+            perGraph.memory = options.memory;
+            perGraph.arenaBytes = options.arenaBytes;
+            componentSolvers.resize(count, BasicMinEdgeCover(perGraph));
+            componentEdges.resize(count);
+        }
+        for (BasicMinEdgeCover& solver : componentSolvers) {
+            solver.options.stop = options.stop;
+        }
+    }
+
+    // options.reorder: the first sub-solver matches the relabelled graph,
+    // with this solver's threads and reductions, and its mates are mapped
+    // back through vertexOrder
+    template <bool Collect>
+    int matchReordered(unsigned threads, SolveStats* stats, Workspace& ws) {
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start;
+        if constexpr (Collect) start = Clock::now();
+
+        addSubSolvers(1);
+        BasicMinEdgeCover& solver = componentSolvers[0];
+        if (!reordered) {
+            VertexReordering::order(graph, options.reorder, vertexOrder);
+            solver = BasicMinEdgeCover(VertexReordering::relabel(graph, vertexOrder, vertexRank), solver.options);
+            reordered = true;
+        }
+
+        Clock::time_point solveStart;
+        if constexpr (Collect) solveStart = Clock::now();
+        SolveStats part;
+        solver.options.threads = threads;
+        solver.options.reduce = options.reduce;
+        int augmentations = solver.withWorkspaceOn(borrowed(ws), [&](Workspace& sub) {
+            return solver.findMaxMatching<Collect>(solver.resolveEngine(), &part, sub);
+        });
+        solver.options.threads = 1;
+        solver.options.reduce = false;
+        gap = solver.gap;
+        interrupted = solver.interrupted;
+        std::chrono::nanoseconds solveTime{0};
+        if constexpr (Collect) solveTime = Clock::now() - solveStart;
+
+        const std::vector<int>& mates = solver.mates();
+        for (int i = 0; i < n; i++) {
+            match[vertexOrder[i]] = mates[i] == -1 ? -1 : vertexOrder[mates[i]];
+        }
+
+        if constexpr (Collect) {
+            *stats = part;
+            stats->reorderTime = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start) - solveTime;
+            // the relabelled copy counts like this solver's own graph
+            stats->workspaceBytes += solver.storage.bytes() + (vertexOrder.capacity() + vertexRank.capacity()) * sizeof(int);
+        }
+        return augmentations;
+    }
+
+    // options.reduce: the reductions settle what they can, the kernel left
+    // is matched as a graph of its own, and the folds are undone on top
+    template <bool Collect>
+    int matchReduced(unsigned threads, SolveStats* stats, Workspace& ws) {
+        using Counters = typename std::conditional<Collect, WorkCounters, NoCounters>::type;
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start;
+        if constexpr (Collect) start = Clock::now();
+
+        MatchingReducer<View, Counters> reducer(graph, n, match, &reductionScratch);
+        reducer.reduce();
+        addSubSolvers(1);
+        BasicMinEdgeCover& solver = componentSolvers[0];
+        std::vector<Edge>& edges = componentEdges[0];
+        int kernelVertices = reducer.kernel(edges);
+
+        SolveStats part;
+        int augmentations = 0;
+        std::chrono::nanoseconds kernelTime{0};
+        if (kernelVertices > 0) {
+            Clock::time_point kernelStart;
+            if constexpr (Collect) kernelStart = Clock::now();
+            solver.options.threads = threads;
+            solver.assign(kernelVertices, edges);
+            augmentations = solver.withWorkspaceOn(borrowed(ws), [&](Workspace& sub) {
+                return solver.findMaxMatching<Collect>(solver.resolveEngine(), &part, sub);
+            });
+            solver.options.threads = 1;
+            gap = solver.gap;
+            interrupted = solver.interrupted;
+            if constexpr (Collect) kernelTime = Clock::now() - kernelStart;
+        } else {
+            solver.clearGraph();
+        }
+        reducer.lift(solver.mates());
+
+        if constexpr (Collect) {
+            accumulate(*stats, part);
+            stats->reduceTime = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start) - kernelTime;
+            stats->degreeOneMatches = reducer.degreeOneMatches();
+            stats->folds = reducer.folds();
+            stats->initialMatchingSize += reducer.degreeOneMatches() + reducer.folds();
+            stats->kernelVertices = kernelVertices;
+            stats->kernelEdges = edges.size();
+            collect(reducer, stats);
+        }
+        return augmentations;
+    }
+
+    // Matches the cyclic components as separate graphs, each with the
+    // engine that suits it. Bipartite components holding more than one
+    // thread's share of the vertices go first, one at a time on every
+    // thread. The rest are pulled largest first from a shared counter by
+    // single-threaded workers, so a huge blossom component keeps one worker
+    // busy while the others drain the small ones
+    template <bool Collect>
+    int matchComponents(unsigned threads, SolveStats* stats, Workspace& ws) {
+        unsigned workers = static_cast<unsigned>(std::min<size_t>(threads, components.size()));
+        addSubSolvers(workers);
+        ws.parent.resize(n);
+        int* local = ws.parent.data();
+        int augmentations = 0;
+        std::atomic<int> gaps{0};
+        std::atomic<bool> stopped{false};
+
+        // with the options asking for per-solve buffers, each worker's comes
+        // from this solve's resource, behind a lock when workers share it
+        Workspace* own = borrowed(ws);
+        std::unique_ptr<SynchronizedResource> shared;
+        std::deque<Workspace> spaces;
+        if (own != nullptr) {
+            std::pmr::memory_resource* memory = ws.resource();
+            if (workers > 1) {
+                shared.reset(new SynchronizedResource(memory));
+                memory = shared.get();
+            }
+            for (unsigned w = 0; w < workers; w++) spaces.emplace_back(memory);
+        }
+        auto spaceOf = [&](unsigned w) { return own != nullptr ? &spaces[w] : nullptr; };
+
+        size_t first = 0;
+        if (threads > 1) {
+            BasicMinEdgeCover& solver = componentSolvers[0];
+            solver.options.threads = threads;
+            while (first < components.size() && components[first].count == 1 &&
+                   engineFor(components[first]) == MatchingEngine::HopcroftKarp &&
+                   static_cast<size_t>(components[first].size) * threads > cyclicOrder.size()) {
+                augmentations += solveComponent<Collect>(components[first++], solver, spaceOf(0), componentEdges[0],
+                                                         local, stats, gaps, stopped);
+            }
+            solver.options.threads = 1;
+        }
+
+        std::atomic<int> pooled{0};
+        std::vector<SolveStats> tallies(Collect ? workers : 0);   // per worker
+        parallelChunks(workers, components.size() - first, [&](unsigned w, size_t begin, size_t end) {
+            SolveStats* tally = Collect ? &tallies[w] : nullptr;
+            for (size_t k = first + begin; k < first + end; k++) {
+                int found = solveComponent<Collect>(components[k], componentSolvers[w], spaceOf(w), componentEdges[w],
+                                                    local, tally, gaps, stopped);
+                pooled.fetch_add(found, std::memory_order_relaxed);
+            }
+        }, 1);
+        if constexpr (Collect) {
+            for (const SolveStats& tally : tallies) accumulate(*stats, tally);
+        }
+        gap = gaps.load();
+        interrupted = stopped.load();
+        return augmentations + pooled.load();
+    }
+
+    // find maximum matching; the result lives only in the mate array.
+    // Returns the number of augmentations after the warm start. With
+    // Collect == false no clock is read and every counter compiles away
+    template <bool Collect>
+    int findMaxMatching(MatchingEngine engine, SolveStats* stats, Workspace& ws) {
+        using Counters = typename std::conditional<Collect, WorkCounters, NoCounters>::type;
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point start;
+        if constexpr (Collect) start = Clock::now();
+
+        match.assign(n, -1);
+        gap = 0;
+        interrupted = false;
+        unsigned threads = resolveThreads(options.threads);
+        // a seeded solve runs on the input numbering and the whole graph
+        bool seeded = !seed.empty();
+        if (!seeded) seedKept = seedDropped = seedUnpaired = 0;
+        if (!seeded && options.reorder != VertexOrder::Input) return matchReordered<Collect>(threads, stats, ws);
+        if (!seeded && options.reduce) return matchReduced<Collect>(threads, stats, ws);
+        Counters counters;
+        // the tree components are done exactly here; the engines only see
+        // the rest, and a forest needs no engine at all
+        matchForest(counters, ws);
+        bool cyclic = treeOrder.size() < static_cast<size_t>(n);
+        if (!seeded && cyclic && splitComponents(threads)) {
+            // the phase times are then summed over the components
+            if constexpr (Collect) {
+                stats->warmStartTime = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+                stats->initialMatchingSize = static_cast<int>((n - std::count(match.begin(), match.end(), -1)) / 2);
+                stats->work.merge(counters);
             }
+            return matchComponents<Collect>(threads, stats, ws);
+        }
+        // a solve that is already asked to stop takes the cheapest maximal
+        // matching, the engine then stopping at once
+        bool hurry = options.stop != nullptr && options.stop->stopRequested();
+        if (seeded) {
+            seededMatching(counters);
+        } else if (cyclic && (engine == MatchingEngine::Greedy || hurry)) {
+            greedyMatching(counters);
+        } else if (cyclic && isDense()) {
+            denseGreedyMatching(*denseRows(), counters, ws);
+        } else if (cyclic) {
+            KarpSipserMatcher<View, Counters> warmStart(graph, n, match, threads, &warmStartScratch);
+            warmStart.run();
+            if constexpr (Collect) collect(warmStart, stats);
+        }
+
+        if constexpr (Collect) {
+            Clock::time_point warm = Clock::now();
+            stats->warmStartTime = std::chrono::duration_cast<std::chrono::nanoseconds>(warm - start);
+            stats->initialMatchingSize = static_cast<int>((n - std::count(match.begin(), match.end(), -1)) / 2);
+            start = warm;
+        }
+
+        int augmentations = cyclic ? augment<Collect>(engine, threads, counters, stats, ws) : 0;
+
+        if constexpr (Collect) {
+            stats->augmentTime = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            stats->augmentations = augmentations;
+            stats->work.merge(counters);
         }
+        return augmentations;
+    }
+
+    // ws when it holds the buffers of this solve only, on options.memory or
+    // in its arena, else null: the sub-solves then allocate from that too
+    Workspace* borrowed(Workspace& ws) const {
+        return options.memory == nullptr && options.arenaBytes == 0 ? nullptr : &ws;
+    }
+
+    // a sub-solve on a workspace of the parent solve's resource, or on its
+    // own as below when space is null
+    template <typename Fn>
+    auto withWorkspaceOn(Workspace* space, Fn fn) {
+        if (space == nullptr) return withWorkspace(fn);
+        return fn(*space);
+    }
+
+    // runs fn on the workspace the options ask for: the solver's own, one
+    // on options.memory, or one in an arena that is dropped afterwards
+    template <typename Fn>
+    auto withWorkspace(Fn fn) {
+        if (options.memory == nullptr && options.arenaBytes == 0) {
+            return fn(workspace);
+        }
+        std::pmr::memory_resource* upstream = options.memory ? options.memory : std::pmr::get_default_resource();
+        if (options.arenaBytes == 0) {
+            Workspace local(upstream);
+            return fn(local);
+        }
+        std::pmr::monotonic_buffer_resource arena(options.arenaBytes, upstream);
+        Workspace local(&arena);
+        return fn(local);
+    }
+
+    // solveDetailed() with or without the per-phase statistics
+    template <bool Collect>
+    CoverResult solveWith(SolveStats* stats, Workspace& ws) {
+        CoverResult report;
+        report.engine = resolveEngine();
+
+        auto start = std::chrono::steady_clock::now();
+        report.augmentations = findMaxMatching<Collect>(report.engine, stats, ws);
+        auto matched = std::chrono::steady_clock::now();
+
+        matchingEdges(report.edges);
+        report.matchingSize = static_cast<int>(report.edges.size());
+        report.gapBound = gap;
+        report.stopped = interrupted;
+        report.seedKept = seedKept;
+        report.seedDropped = seedDropped;
+        report.seedUnpaired = seedUnpaired;
+
+        completeCover(report.edges, ws);
+        auto done = std::chrono::steady_clock::now();
+
+        report.matchingTime = std::chrono::duration_cast<std::chrono::nanoseconds>(matched - start);
+        report.completionTime = std::chrono::duration_cast<std::chrono::nanoseconds>(done - matched);
+        if constexpr (Collect) {
+            stats->vertices = n;
+            stats->edges = graph.edgeCount();
+            stats->completionTime = report.completionTime;
+            stats->matchingSize = report.matchingSize;
+            // the graph is counted only when the solver owns it
+            stats->workspaceBytes += storage.bytes() + match.capacity() * sizeof(int) + side.capacity() + dense.bytes();
+        }
+        return report;
+    }
 
-        return matching;
+    // materializes the matching as edges into matching, once, after all
+    // augmentations
+    void matchingEdges(std::vector<Edge>& matching) const {
+        matching.clear();
+        for (int i = 0; i < n; i++) {
+            if (match[i] != -1 && i < match[i]) {
+                matching.push_back(Edge(i, match[i]));
+            }
+        }
     }
 
 public:
-    MinEdgeCover(int vertices, const std::vector<Edge>& edgeList)
-        : n(vertices), edges(edgeList), adj(vertices) {
+    // an empty solver, to be given its graph by assign()
+    explicit BasicMinEdgeCover(SolverOptions options = {}) : options(options) {
+        clearGraph();
+    }
+
+    BasicMinEdgeCover(int vertices, const std::vector<Edge>& edgeList, SolverOptions options = {})
+        : options(options) {
+        assign(vertices, edgeList);
+    }
+
+    // takes a prebuilt CSR graph as is, without copying it
+    BasicMinEdgeCover(Storage csr, SolverOptions options = {})
+        : n(static_cast<int>(csr.n)), storage(std::move(csr)), options(options) {
+
+        if (n <= 0 || storage.n > static_cast<uint32_t>(INT_MAX)) {
+            throw std::invalid_argument("Number of vertices must be positive");
+        }
+        if (storage.offsets.size() != storage.n + static_cast<size_t>(1) ||
+            storage.offsets.back() != storage.neighbors.size()) {
+            throw std::invalid_argument("Malformed CSR graph");
+        }
+        graph = storage.view();
+        validate(graph);
+        init();
+    }
+
+    // reads arrays owned by the caller (e.g. a MappedGraph), which must
+    // outlive the solver; nothing is copied
+    BasicMinEdgeCover(const View& view, SolverOptions options = {})
+        : n(static_cast<int>(view.n)), graph(view), options(options) {
+
+        if (n <= 0 || view.n > static_cast<uint32_t>(INT_MAX)) {
+            throw std::invalid_argument("Number of vertices must be positive");
+        }
+        if (view.offsets == nullptr || (view.neighbors == nullptr && view.offsets[view.n] != 0)) {
+            throw std::invalid_argument("Malformed CSR graph");
+        }
+        validate(graph);
+        init();
+    }
+
+    // a copy reads its own copy of the graph, or the same borrowed arrays
+    BasicMinEdgeCover(const BasicMinEdgeCover& other)
+        : n(other.n), storage(other.storage), graph(other.graph), options(other.options),
+          side(other.side), bipartite(other.bipartite), treeOrder(other.treeOrder), match(other.match),
+          cyclicOrder(other.cyclicOrder), components(other.components) {
+        if (other.ownsGraph()) graph = storage.view();
+    }
+
+    BasicMinEdgeCover& operator=(const BasicMinEdgeCover& other) {
+        if (this != &other) {
+            BasicMinEdgeCover copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    // moving a vector keeps its buffer, so the view stays valid
+    BasicMinEdgeCover(BasicMinEdgeCover&&) = default;
+    BasicMinEdgeCover& operator=(BasicMinEdgeCover&&) = default;
 
+    // Replaces the graph with a new one built from edgeList. Every buffer
+    // of the solver, the CSR arrays and the engine workspaces included,
+    // keeps its capacity, so one solver reused for many small graphs stops
+    // allocating once it has seen the largest of them.
+    void assign(int vertices, const Edge* edgeList, size_t count) {
         if (vertices <= 0) {
             throw std::invalid_argument("Number of vertices must be positive");
         }
+        clearGraph();
+        storage.assign(static_cast<uint32_t>(vertices), edgeList, count);
+        n = vertices;
+        graph = storage.view();
+        try {
+            init();
+        } catch (...) {
+            // a rejected graph leaves the solver empty, ready for the next one
+            clearGraph();
+            throw;
+        }
+    }
+
+    void assign(int vertices, const std::vector<Edge>& edgeList) {
+        assign(vertices, edgeList.data(), edgeList.size());
+    }
 
-        // build adjacency list
-        for (const auto& e : edges) {
-            if (e.u < 0 || e.u >= n || e.v < 0 || e.v >= n) {
+    bool isBipartite() const { return bipartite; }
+    const View& csr() const { return graph; }
+
+    // The input edge index behind every cover edge, for a graph built with
+    // edge ids (CSRGraph::fromEdges(n, edges, true), NormalizedEdges::
+    // toCSR()). Each edge is looked up in the shorter of its two rows
+    void coverEdgeIds(const std::vector<Edge>& cover, std::vector<Offset>& ids) const {
+        if (!graph.hasEdgeIds()) {
+            throw std::invalid_argument("Graph was built without edge ids");
+        }
+        ids.clear();
+        ids.reserve(cover.size());
+        for (const auto& e : cover) {
+            uint32_t a = static_cast<uint32_t>(e.u), b = static_cast<uint32_t>(e.v);
+            if (a >= graph.n || b >= graph.n) {
                 throw std::invalid_argument("Invalid vertex index");
             }
-            adj[e.u].push_back(e.v);
-            adj[e.v].push_back(e.u);
-        }
-
-        // check for isolated vertices
-        for (int i = 0; i < n; i++) {
-            if (adj[i].empty()) {
-                throw std::invalid_argument("Graph contains isolated vertices - edge cover impossible");
+            if (graph.degree(b) < graph.degree(a)) std::swap(a, b);
+            Offset slot = graph.offsets[a], end = graph.offsets[a + 1];
+            while (slot < end && graph.neighbors[slot] != b) slot++;
+            if (slot == end) {
+                throw std::invalid_argument("Cover edge is not in the graph");
             }
+            ids.push_back(graph.edgeIds[slot]);
         }
     }
 
     std::vector<Edge> solve() {
-        std::vector<Edge> matching = findMaxMatching();
-        std::vector<bool> covered(n, false);
-        std::vector<Edge> result = matching;
+        return solveDetailed().edges;
+    }
+
+    // solve() warm-started from a mate array or an edge set, as given to
+    // warmStartFrom()
+    std::vector<Edge> solve(const std::vector<int>& initialMates) {
+        warmStartFrom(initialMates);
+        return solve();
+    }
+
+    std::vector<Edge> solve(const std::vector<Edge>& initialEdges) {
+        warmStartFrom(initialEdges);
+        return solve();
+    }
+
+    // computes only the maximum matching and returns the solver's own mate
+    // array (match[v] is v's partner or -1), without building any Edge
+    const std::vector<int>& solveMatching() {
+        withWorkspace([&](Workspace& ws) { return findMaxMatching<false>(resolveEngine(), nullptr, ws); });
+        return match;
+    }
+
+    // solve() into a caller-owned vector, reusing its capacity
+    void solveInto(std::vector<Edge>& cover) {
+        withWorkspace([&](Workspace& ws) {
+            findMaxMatching<false>(resolveEngine(), nullptr, ws);
+            matchingEdges(cover);
+            completeCover(cover, ws);
+        });
+    }
+
+    // mate array of the last solve, empty before the first one
+    const std::vector<int>& mates() const { return match; }
+
+    // CoverResult::gapBound of the last solve: the cover has at most this
+    // many edges more than a minimum one
+    int gapBound() const { return gap; }
+
+    // Makes the next solve start from mates, the mate array of the same or
+    // a similar graph, instead of its own warm start: the pairs that are
+    // edges of this graph are kept, the others dropped, and the engine
+    // only searches from the vertices left free. The reorder, reduce and
+    // per-component stages are skipped for that solve
+    void warmStartFrom(const std::vector<int>& mates) {
+        if (n == 0) {
+            throw std::logic_error("No graph to warm-start");
+        }
+        if (mates.size() != static_cast<size_t>(n)) {
+            throw std::invalid_argument("Seed matching does not have one mate per vertex");
+        }
+        seed = mates;
+        seedUnpaired = 0;
+    }
 
-        // mark covered vertices
-        for (const auto& e : matching) {
-            covered[e.u] = true;
-            covered[e.v] = true;
+    // The same from a set of edges, such as the matching or the cover of a
+    // previous solve: they are paired greedily, in order, into a mate
+    // array, an edge being left out when it is a self-loop, has an endpoint
+    // out of range or meets one taken before; CoverResult::seedUnpaired
+    // counts those, apart from the pairs the solve then drops. Each star of
+    // a minimum cover gives exactly one pair, so a previous cover seeds a
+    // maximum matching of its own graph. O(V + |edges|) on top of the solve
+    void warmStartFrom(const std::vector<Edge>& edges) {
+        if (n == 0) {
+            throw std::logic_error("No graph to warm-start");
+        }
+        seed.assign(n, -1);
+        int unpaired = 0;
+        for (const Edge& e : edges) {
+            if (e.u < 0 || e.v < 0 || e.u >= n || e.v >= n || e.u == e.v || seed[e.u] != -1 || seed[e.v] != -1) {
+                unpaired++;
+                continue;
+            }
+            seed[e.u] = e.v;
+            seed[e.v] = e.u;
         }
+        seedUnpaired = unpaired;
+    }
 
-        // for each uncovered vertex, add any incident edge
-        for (int i = 0; i < n; i++) {
-            if (!covered[i]) {
-                for (const auto& e : edges) {
-                    if (e.u == i || e.v == i) {
-                        result.push_back(e);
-                        covered[i] = true;
-                        covered[e.u] = true;
-                        covered[e.v] = true;
-                        break;
-                    }
+    // CoverResult::stopped of the last solve
+    bool wasStopped() const { return interrupted; }
+
+    // replaces SolverOptions::stop for the solves to come; nullptr runs
+    // them to the end
+    void setStopSignal(const StopSignal* signal) { options.stop = signal; }
+
+    // Certificate that the matching of the last solve is maximum, so its
+    // cover is minimum: one blossom sweep over the Hungarian trees, O(V + E)
+    // up to the union-find. Throws std::logic_error before the first solve
+    // and when that matching is not maximum (the Greedy engine)
+    MatchingCertificate certificate() {
+        if (n == 0 || match.size() != static_cast<size_t>(n)) {
+            throw std::logic_error("No matching to certify before the first solve");
+        }
+        MatchingCertificate proof;
+        proof.mates = match;
+        std::vector<uint8_t> outer;
+        bool maximum = withWorkspace([&](Workspace& ws) {
+            BlossomMatcher<View> matcher(graph, n, proof.mates, &ws.blossom);
+            matcher.useBitRows(denseRows());
+            return matcher.markExposable(outer);
+        });
+        if (!maximum) {
+            throw std::logic_error("Matching of the last solve is not maximum");
+        }
+        for (int v = 0; v < n; v++) {
+            if (outer[v]) continue;
+            for (int w : graph[v]) {
+                if (outer[w]) {
+                    proof.barrier.push_back(v);
+                    break;
                 }
             }
         }
+        return proof;
+    }
+
+    // same as solve(), also reporting the engine that ran and stage timings
+    CoverResult solveDetailed() {
+        return withWorkspace([&](Workspace& ws) { return solveWith<false>(nullptr, ws); });
+    }
 
-        return result;
+    // as above, and fills stats with the per-phase breakdown: warm start,
+    // augmentation and completion times, matching sizes, work counters and
+    // workspace size. Only this overload instantiates the counting code
+    CoverResult solveDetailed(SolveStats& stats) {
+        stats = SolveStats();
+        return withWorkspace([&](Workspace& ws) { return solveWith<true>(&stats, ws); });
     }
 
-    // check if the given set is an edge cover
+    // check if the given set is an edge cover: every vertex touched, with
+    // no check that the edges exist (CoverVerifier also checks minimality)
     static bool isEdgeCover(int n, const std::vector<Edge>& cover) {
-        std::vector<bool> covered(n, false);
+        std::vector<uint8_t> covered(n, 0);
         for (const auto& e : cover) {
-            covered[e.u] = true;
-            covered[e.v] = true;
+            covered[e.u] = 1;
+            covered[e.v] = 1;
         }
         for (int i = 0; i < n; i++) {
             if (!covered[i]) return false;
@@ -168,4 +3228,8 @@ public:
     }
 };
 
-#endif // MIN_EDGE_COVER_HPP
\ No newline at end of file
+using MinEdgeCover = BasicMinEdgeCover<>;
+using CompactMinEdgeCover = BasicMinEdgeCover<uint16_t, uint32_t>;
+using WideMinEdgeCover = BasicMinEdgeCover<uint32_t, uint64_t>;
+
+#endif // MIN_EDGE_COVER_HPP
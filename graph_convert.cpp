@@ -0,0 +1,66 @@
+#include <iostream>
+#include <string>
+#include "graph_io.hpp"
+#include "semi_external_cover.hpp"
+
+void usage() {
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << "  graph_convert text2bin <graph.txt> <graph.mecg> [cover.mecc]" << std::endl;
+    std::cerr << "  graph_convert bin2text <graph.mecg> <graph.txt> [cover.mecc]" << std::endl;
+    std::cerr << "  graph_convert edges2bin <edges.txt> <graph.mecg> [threads]" << std::endl;
+    std::cerr << "  graph_convert solve <graph.mecg> <cover.mecc>" << std::endl;
+    std::cerr << "  graph_convert stream <graph.mecg> <cover.mecc> [memory MB]" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4 || argc > 5) {
+        usage();
+        return 1;
+    }
+    std::string mode = argv[1];
+    std::string cover = argc == 5 ? argv[4] : "";
+
+    try {
+        if (mode == "text2bin") {
+            convertTextToBinary(argv[2], argv[3], cover);
+        } else if (mode == "bin2text") {
+            convertBinaryToText(argv[2], argv[3], cover);
+        } else if (mode == "edges2bin") {
+            // plain "u v" edge list, parsed on several threads
+            TextParseOptions parse;
+            parse.threads = argc == 5 ? static_cast<unsigned>(std::stoul(argv[4])) : 0;
+            parse.progress = [](uint64_t done, uint64_t total) {
+                std::cerr << "\rParsed " << (total ? 100 * done / total : 100) << "%" << std::flush;
+            };
+            CSRGraph g = readEdgeListCSR(argv[2], parse, true);
+            std::cerr << std::endl;
+            writeBinaryGraph(argv[3], g);
+            std::cout << "Vertices: " << g.n << ", edges: " << g.edgeCount() << std::endl;
+        } else if (mode == "solve" && argc == 4) {
+            // the solver reads the mapped file directly
+            MappedGraph mapped(argv[2]);
+            MinEdgeCover mec(mapped.view());
+            CoverResult result = mec.solveDetailed();
+            writeBinaryCover(argv[3], static_cast<int>(mapped.view().n), result.edges);
+            std::cout << "Matching engine: " << engineName(result.engine) << std::endl;
+            std::cout << "Number of edges in cover: " << result.edges.size() << std::endl;
+        } else if (mode == "stream") {
+            // semi-external: O(V) memory, the edges streamed from the file
+            SemiExternalOptions semi;
+            semi.memoryLimit = argc == 5 ? static_cast<size_t>(std::stoul(argv[4])) << 20 : 0;
+            SemiExternalCover solver(argv[2], semi);
+            SemiExternalStats stats;
+            std::vector<Edge> edges = solver.solve(stats);
+            writeBinaryCover(argv[3], static_cast<int>(solver.vertexCount()), edges);
+            std::cout << "Number of edges in cover: " << edges.size() << (stats.exact ? " (minimum)" : "") << std::endl;
+            std::cout << "Passes: " << stats.passes << ", streamed " << (stats.bytesStreamed >> 20) << " MB" << std::endl;
+        } else {
+            usage();
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,608 @@
+#ifndef GRAPH_IO_HPP
+#define GRAPH_IO_HPP
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include "graph.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Binary graph format, version 1. The file is the CSR layout itself, so it
+// can be mapped and handed to the solver without any parsing. All fields
+// are little-endian:
+//
+//   offset  size          field
+//   0       4             magic "MECG"
+//   4       4             version (1)
+//   8       4             flags (bit 0: edge ids present)
+//   12      4             n, number of vertices
+//   16      8             slots, the number of neighbour entries (2 * |E|)
+//   24      4 * (n + 1)   offsets
+//   ...     4 * slots     neighbors
+//   ...     4 * slots     edgeIds, only with flag bit 0
+//
+// Covers use the same style ("MECC"): magic, version, n, k, then k
+// little-endian (u, v) pairs of 32-bit vertex indices.
+struct BinaryFormat {
+    static constexpr char graphMagic[4] = {'M', 'E', 'C', 'G'};
+    static constexpr char coverMagic[4] = {'M', 'E', 'C', 'C'};
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t edgeIdsFlag = 1;
+
+    struct GraphHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t flags;
+        uint32_t n;
+        uint64_t slots;
+    };
+
+    struct CoverHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t n;
+        uint32_t k;
+    };
+
+    static void requireLittleEndian() {
+        const uint32_t probe = 1;
+        unsigned char first;
+        std::memcpy(&first, &probe, 1);
+        if (first != 1) {
+            throw std::runtime_error("Binary graph files need a little-endian host");
+        }
+    }
+
+    // checks a header against the size of the file it came from
+    static void checkGraphHeader(const GraphHeader& h, uint64_t fileSize) {
+        if (std::memcmp(h.magic, graphMagic, 4) != 0) {
+            throw std::invalid_argument("Not a binary graph file");
+        }
+        if (h.version != version) {
+            throw std::invalid_argument("Unsupported binary graph version");
+        }
+        if (h.slots > UINT32_MAX) {
+            throw std::invalid_argument("Malformed binary graph file");
+        }
+        uint64_t arrays = (static_cast<uint64_t>(h.n) + 1 + h.slots * ((h.flags & edgeIdsFlag) ? 2 : 1)) * 4;
+        if (fileSize != sizeof(GraphHeader) + arrays) {
+            throw std::invalid_argument("Malformed binary graph file");
+        }
+    }
+
+    // offsets must end at slots; the rest is checked by the solver or by
+    // checkGraphRows()
+    static void checkGraphArrays(const CSRView& g, uint64_t slots) {
+        if (g.offsets[0] != 0 || g.offsets[g.n] != slots) {
+            throw std::invalid_argument("Malformed binary graph file");
+        }
+    }
+
+    // the rest, for readers that walk the rows themselves: offsets that
+    // never decrease, neighbours below n. O(V + E)
+    static void checkGraphRows(const CSRView& g) {
+        for (uint32_t u = 0; u < g.n; u++) {
+            if (g.offsets[u + 1] < g.offsets[u]) {
+                throw std::invalid_argument("Malformed binary graph file");
+            }
+        }
+        for (uint32_t i = 0; i < g.offsets[g.n]; i++) {
+            if (g.neighbors[i] >= g.n) {
+                throw std::invalid_argument("Invalid vertex index");
+            }
+        }
+    }
+};
+static_assert(sizeof(BinaryFormat::GraphHeader) == 24, "graph header must have no padding");
+static_assert(sizeof(BinaryFormat::CoverHeader) == 16, "cover header must have no padding");
+
+// stdio file that closes itself and throws on short reads and writes
+class BinaryFile {
+private:
+    std::FILE* f;
+
+public:
+    BinaryFile(const std::string& path, const char* mode) : f(std::fopen(path.c_str(), mode)) {
+        if (f == nullptr) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+    }
+    ~BinaryFile() {
+        if (f != nullptr) std::fclose(f);
+    }
+    BinaryFile(const BinaryFile&) = delete;
+    BinaryFile& operator=(const BinaryFile&) = delete;
+
+    void write(const void* data, size_t bytes) {
+        if (bytes != 0 && std::fwrite(data, 1, bytes, f) != bytes) {
+            throw std::runtime_error("Failed to write file");
+        }
+    }
+
+    void read(void* data, size_t bytes) {
+        if (bytes != 0 && std::fread(data, 1, bytes, f) != bytes) {
+            throw std::invalid_argument("Truncated binary file");
+        }
+    }
+
+    uint64_t size() {
+        std::fseek(f, 0, SEEK_END);
+        long end = std::ftell(f);
+        std::fseek(f, 0, SEEK_SET);
+        if (end < 0) {
+            throw std::runtime_error("Failed to read file size");
+        }
+        return static_cast<uint64_t>(end);
+    }
+
+    void close() {
+        int rc = std::fclose(f);
+        f = nullptr;
+        if (rc != 0) {
+            throw std::runtime_error("Failed to write file");
+        }
+    }
+};
+
+inline void writeBinaryGraph(const std::string& path, const CSRView& g) {
+    BinaryFormat::requireLittleEndian();
+    BinaryFormat::GraphHeader h;
+    std::memcpy(h.magic, BinaryFormat::graphMagic, 4);
+    h.version = BinaryFormat::version;
+    h.flags = g.hasEdgeIds() ? BinaryFormat::edgeIdsFlag : 0;
+    h.n = g.n;
+    h.slots = g.offsets[g.n];
+
+    BinaryFile out(path, "wb");
+    out.write(&h, sizeof(h));
+    out.write(g.offsets, (static_cast<size_t>(g.n) + 1) * 4);
+    out.write(g.neighbors, h.slots * 4);
+    if (g.hasEdgeIds()) out.write(g.edgeIds, h.slots * 4);
+    out.close();
+}
+
+inline void writeBinaryGraph(const std::string& path, const CSRGraph& g) {
+    writeBinaryGraph(path, g.view());
+}
+
+// reads a binary graph into owned arrays with plain block reads
+inline CSRGraph readBinaryGraph(const std::string& path) {
+    BinaryFormat::requireLittleEndian();
+    BinaryFile in(path, "rb");
+    uint64_t fileSize = in.size();
+    BinaryFormat::GraphHeader h;
+    if (fileSize < sizeof(h)) {
+        throw std::invalid_argument("Not a binary graph file");
+    }
+    in.read(&h, sizeof(h));
+    BinaryFormat::checkGraphHeader(h, fileSize);
+
+    CSRGraph g;
+    g.n = h.n;
+    g.offsets.resize(static_cast<size_t>(h.n) + 1);
+    g.neighbors.resize(h.slots);
+    in.read(g.offsets.data(), g.offsets.size() * 4);
+    in.read(g.neighbors.data(), g.neighbors.size() * 4);
+    if (h.flags & BinaryFormat::edgeIdsFlag) {
+        g.edgeIds.resize(h.slots);
+        in.read(g.edgeIds.data(), g.edgeIds.size() * 4);
+    }
+    BinaryFormat::checkGraphArrays(g.view(), h.slots);
+    return g;
+}
+
+// A whole file mapped read-only into memory, or read into a private
+// buffer where mmap is not available. The data is 8-byte aligned.
+class MappedFile {
+private:
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    std::vector<uint64_t> buffer;   // fallback storage without mmap
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to read file size: " + path);
+        }
+        length = static_cast<size_t>(st.st_size);
+        if (length > 0) {
+            void* base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Failed to map file: " + path);
+            }
+            bytes = static_cast<const unsigned char*>(base);
+            mapped = true;
+        }
+        ::close(fd);
+#else
+        BinaryFile in(path, "rb");
+        length = static_cast<size_t>(in.size());
+        buffer.resize((length + 7) / 8);
+        in.read(buffer.data(), length);
+        bytes = reinterpret_cast<const unsigned char*>(buffer.data());
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (mapped) munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    // the file will be read front to back
+    void adviseSequential() const {
+#ifndef _WIN32
+        if (mapped) madvise(const_cast<unsigned char*>(bytes), length, MADV_SEQUENTIAL);
+#endif
+    }
+
+    // drops the pages of [from, to) once they have been consumed
+    void release(size_t from, size_t to) const {
+#ifndef _WIN32
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        from = (from + page - 1) / page * page;
+        to = std::min(to, length) / page * page;
+        if (mapped && from < to) madvise(const_cast<unsigned char*>(bytes) + from, to - from, MADV_DONTNEED);
+#else
+        (void)from;
+        (void)to;
+#endif
+    }
+};
+
+// A binary graph file mapped into memory. view() points straight into the
+// mapping, so a solver built on it starts without reading the file; pages
+// are faulted in as the solver touches them.
+class MappedGraph {
+private:
+    MappedFile file;
+    CSRView graph;
+
+public:
+    explicit MappedGraph(const std::string& path) : file(path) {
+        BinaryFormat::requireLittleEndian();
+        BinaryFormat::GraphHeader h;
+        if (file.size() < sizeof(h)) {
+            throw std::invalid_argument("Not a binary graph file");
+        }
+        std::memcpy(&h, file.data(), sizeof(h));
+        BinaryFormat::checkGraphHeader(h, file.size());
+        const uint32_t* arrays = reinterpret_cast<const uint32_t*>(file.data() + sizeof(h));
+        graph.n = h.n;
+        graph.offsets = arrays;
+        graph.neighbors = arrays + h.n + 1;
+        graph.edgeIds = (h.flags & BinaryFormat::edgeIdsFlag) ? graph.neighbors + h.slots : nullptr;
+        BinaryFormat::checkGraphArrays(graph, h.slots);
+    }
+
+    const CSRView& view() const { return graph; }
+};
+
+inline void writeBinaryCover(const std::string& path, int n, const std::vector<Edge>& cover) {
+    BinaryFormat::requireLittleEndian();
+    BinaryFormat::CoverHeader h;
+    std::memcpy(h.magic, BinaryFormat::coverMagic, 4);
+    h.version = BinaryFormat::version;
+    h.n = static_cast<uint32_t>(n);
+    h.k = static_cast<uint32_t>(cover.size());
+
+    std::vector<uint32_t> pairs;
+    pairs.reserve(2 * cover.size());
+    for (const auto& e : cover) {
+        pairs.push_back(static_cast<uint32_t>(e.u));
+        pairs.push_back(static_cast<uint32_t>(e.v));
+    }
+    BinaryFile out(path, "wb");
+    out.write(&h, sizeof(h));
+    out.write(pairs.data(), pairs.size() * 4);
+    out.close();
+}
+
+// returns the cover and stores the vertex count in n
+inline std::vector<Edge> readBinaryCover(const std::string& path, int& n) {
+    BinaryFormat::requireLittleEndian();
+    BinaryFile in(path, "rb");
+    uint64_t fileSize = in.size();
+    BinaryFormat::CoverHeader h;
+    if (fileSize < sizeof(h)) {
+        throw std::invalid_argument("Not a binary cover file");
+    }
+    in.read(&h, sizeof(h));
+    if (std::memcmp(h.magic, BinaryFormat::coverMagic, 4) != 0 || h.version != BinaryFormat::version) {
+        throw std::invalid_argument("Not a binary cover file");
+    }
+    if (fileSize != sizeof(h) + static_cast<uint64_t>(h.k) * 8 || h.n > static_cast<uint32_t>(INT_MAX)) {
+        throw std::invalid_argument("Malformed binary cover file");
+    }
+
+    std::vector<uint32_t> pairs(2 * static_cast<size_t>(h.k));
+    in.read(pairs.data(), pairs.size() * 4);
+    std::vector<Edge> cover;
+    cover.reserve(h.k);
+    for (size_t i = 0; i < pairs.size(); i += 2) {
+        if (pairs[i] >= h.n || pairs[i + 1] >= h.n) {
+            throw std::invalid_argument("Invalid vertex index");
+        }
+        cover.push_back(Edge(static_cast<int>(pairs[i]), static_cast<int>(pairs[i + 1])));
+    }
+    n = static_cast<int>(h.n);
+    return cover;
+}
+
+// The text format written by the demo and read by visualize.py: a line
+// "n m k", then the m graph edges and the k cover edges, one "u v" per line.
+struct TextGraph {
+    int n = 0;
+    std::vector<Edge> edges;
+    std::vector<Edge> cover;
+};
+
+inline void writeTextGraph(const std::string& path, int n, const std::vector<Edge>& edges,
+                           const std::vector<Edge>& cover) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    }
+    file << n << " " << edges.size() << " " << cover.size() << "\n";
+    for (const auto& e : edges) {
+        file << e.u << " " << e.v << "\n";
+    }
+    for (const auto& e : cover) {
+        file << e.u << " " << e.v << "\n";
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+}
+
+struct TextParseOptions {
+    unsigned threads = 1;              // parsing threads, 0 = one per hardware thread
+    size_t windowBytes = 256 << 20;    // bytes scanned between progress reports
+    size_t sliceBytes = 1 << 20;       // unit of work handed to one thread
+    std::function<void(uint64_t bytesDone, uint64_t bytesTotal)> progress;
+};
+
+// Edge-list scanner used by the text readers. Lines hold "u v" with
+// non-negative integers separated by blanks; empty lines and lines starting
+// with '#' or '%' are skipped. The file is mapped and processed in windows:
+// each window is cut at newlines into slices that the workers scan with a
+// hand-written integer reader, and the slices are appended in file order,
+// so the edge order of the file is kept.
+class EdgeListParser {
+private:
+    static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    static bool readIndex(const char*& p, const char* end, uint64_t& value) {
+        const char* start = p;
+        value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (value <= static_cast<uint64_t>(INT_MAX)) value = value * 10 + static_cast<uint64_t>(*p - '0');
+            p++;
+        }
+        return p != start;
+    }
+
+    // scans whole lines of [p, end); returns the start of the first bad
+    // line, or nullptr
+    static const char* scan(const char* p, const char* end, std::vector<Edge>& out) {
+        while (p < end) {
+            while (p < end && isBlank(*p)) p++;
+            if (p == end) break;
+            if (*p == '\n') {
+                p++;
+                continue;
+            }
+            const char* line = p;
+            if (*p == '#' || *p == '%') {
+                p = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+                p = p ? p + 1 : end;
+                continue;
+            }
+            uint64_t u, v;
+            if (!readIndex(p, end, u)) return line;
+            if (p == end || !isBlank(*p)) return line;
+            while (p < end && isBlank(*p)) p++;
+            if (!readIndex(p, end, v)) return line;
+            while (p < end && isBlank(*p)) p++;
+            if (p < end && *p != '\n') return line;
+            if (u > static_cast<uint64_t>(INT_MAX) || v > static_cast<uint64_t>(INT_MAX)) return line;
+            out.push_back(Edge(static_cast<int>(u), static_cast<int>(v)));
+        }
+        return nullptr;
+    }
+
+    // first position at or after p that starts a line
+    static const char* lineStart(const char* begin, const char* p, const char* end) {
+        if (p <= begin || p >= end) return std::min(std::max(p, begin), end);
+        if (p[-1] == '\n') return p;
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        return nl ? nl + 1 : end;
+    }
+
+public:
+    // appends the edges of [begin, end) to out; offset is the position of
+    // begin within its file, used in error messages
+    static void parse(const char* begin, const char* end, std::vector<Edge>& out,
+                      const TextParseOptions& options = {}, uint64_t offset = 0,
+                      const MappedFile* file = nullptr) {
+        const unsigned threads = resolveThreads(options.threads);
+        const size_t sliceBytes = std::max<size_t>(options.sliceBytes, 1);
+        const uint64_t total = static_cast<uint64_t>(end - begin);
+        std::vector<std::vector<Edge>> parts;
+        std::vector<const char*> errors;
+
+        // a window's slices are fixed before scanning, so the edge order
+        // does not depend on which worker scans which slice
+        for (const char* window = begin; window < end;) {
+            size_t want = std::max<size_t>(options.windowBytes, sliceBytes);
+            const char* windowEnd = lineStart(begin, window + std::min<size_t>(want, static_cast<size_t>(end - window)), end);
+
+            std::vector<const char*> cuts(1, window);
+            while (cuts.back() < windowEnd) {
+                const char* at = cuts.back() + std::min<size_t>(sliceBytes, static_cast<size_t>(windowEnd - cuts.back()));
+                cuts.push_back(lineStart(begin, at, windowEnd));
+            }
+            size_t slices = cuts.size() - 1;
+            parts.assign(slices, {});
+            errors.assign(slices, nullptr);
+            parallelChunks(threads, slices, [&](unsigned, size_t first, size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    parts[i].reserve((cuts[i + 1] - cuts[i]) / 8);
+                    errors[i] = scan(cuts[i], cuts[i + 1], parts[i]);
+                }
+            }, 1);
+
+            // size the output from the line density seen so far
+            size_t found = 0;
+            for (const auto& part : parts) found += part.size();
+            if (window == begin && found > 0) {
+                double perByte = static_cast<double>(found) / static_cast<double>(windowEnd - window);
+                out.reserve(out.size() + static_cast<size_t>(perByte * static_cast<double>(total) * 1.05) + 16);
+            }
+            for (size_t i = 0; i < slices; i++) {
+                if (errors[i] != nullptr) {
+                    throw std::invalid_argument("Malformed edge list line at byte " +
+                                                std::to_string(offset + static_cast<uint64_t>(errors[i] - begin)));
+                }
+                out.insert(out.end(), parts[i].begin(), parts[i].end());
+            }
+            if (file != nullptr) {
+                file->release(static_cast<size_t>(offset + (window - begin)), static_cast<size_t>(offset + (windowEnd - begin)));
+            }
+            window = windowEnd;
+            if (options.progress) options.progress(static_cast<uint64_t>(window - begin), total);
+        }
+    }
+};
+
+// Reads a plain edge list ("u v" per line). The vertex count is one more
+// than the largest index.
+inline TextGraph readEdgeList(const std::string& path, const TextParseOptions& options = {}) {
+    MappedFile file(path);
+    file.adviseSequential();
+    const char* text = reinterpret_cast<const char*>(file.data());
+
+    TextGraph g;
+    EdgeListParser::parse(text, text + file.size(), g.edges, options, 0, &file);
+    int maxIndex = -1;
+    for (const auto& e : g.edges) {
+        maxIndex = std::max(maxIndex, std::max(e.u, e.v));
+    }
+    if (maxIndex == INT_MAX) {
+        throw std::invalid_argument("Too many vertices");
+    }
+    g.n = maxIndex + 1;
+    return g;
+}
+
+// edge list straight into CSR, keeping the edge order in the edge ids
+inline CSRGraph readEdgeListCSR(const std::string& path, const TextParseOptions& options = {},
+                                bool withEdgeIds = false) {
+    TextGraph g = readEdgeList(path, options);
+    return CSRGraph::fromEdges(static_cast<uint32_t>(g.n), g.edges, withEdgeIds);
+}
+
+// reads the demo format: the "n m k" header, then m graph and k cover edges
+inline TextGraph readTextGraph(const std::string& path, const TextParseOptions& options = {}) {
+    MappedFile file(path);
+    file.adviseSequential();
+    const char* text = reinterpret_cast<const char*>(file.data());
+    const char* end = text + file.size();
+
+    const char* nl = static_cast<const char*>(std::memchr(text, '\n', file.size()));
+    const char* body = nl ? nl + 1 : end;
+    std::istringstream header(std::string(text, body));
+    TextGraph g;
+    size_t m = 0, k = 0;
+    if (!(header >> g.n >> m >> k) || g.n <= 0) {
+        throw std::invalid_argument("Malformed text graph header");
+    }
+
+    EdgeListParser::parse(body, end, g.edges, options, static_cast<uint64_t>(body - text), &file);
+    if (g.edges.size() != m + k) {
+        throw std::invalid_argument("Text graph has " + std::to_string(g.edges.size()) +
+                                    " edge lines, header says " + std::to_string(m + k));
+    }
+    for (const auto& e : g.edges) {
+        if (e.u >= g.n || e.v >= g.n) {
+            throw std::invalid_argument("Invalid vertex index");
+        }
+    }
+    g.cover.assign(g.edges.begin() + m, g.edges.end());
+    g.edges.resize(m);
+    return g;
+}
+
+// converters between the text format and the binary graph/cover files;
+// the binary graph keeps the input edge order in its edge ids
+inline void convertTextToBinary(const std::string& textPath, const std::string& graphPath,
+                                const std::string& coverPath = "") {
+    TextGraph text = readTextGraph(textPath);
+    writeBinaryGraph(graphPath, CSRGraph::fromEdges(static_cast<uint32_t>(text.n), text.edges, true));
+    if (!coverPath.empty()) writeBinaryCover(coverPath, text.n, text.cover);
+}
+
+inline void convertBinaryToText(const std::string& graphPath, const std::string& textPath,
+                                const std::string& coverPath = "") {
+    MappedGraph mapped(graphPath);
+    const CSRView& g = mapped.view();
+    BinaryFormat::checkGraphRows(g);
+
+    // every edge is stored from both ends (a self-loop twice in its own row)
+    // and is emitted once, lower endpoint first; with edge ids it goes back
+    // to its input position
+    std::vector<Edge> edges(g.edgeCount());
+    size_t next = 0;
+    for (uint32_t u = 0; u < g.n; u++) {
+        bool loopHalf = false;
+        for (uint32_t i = g.offsets[u]; i < g.offsets[u + 1]; i++) {
+            uint32_t v = g.neighbors[i];
+            if (v < u) continue;
+            if (v == u) {
+                loopHalf = !loopHalf;
+                if (loopHalf) continue;
+            }
+            size_t slot = g.hasEdgeIds() ? g.edgeIds[i] : next++;
+            if (slot >= edges.size()) {
+                throw std::invalid_argument("Malformed binary graph file");
+            }
+            edges[slot] = Edge(static_cast<int>(u), static_cast<int>(v));
+        }
+    }
+
+    std::vector<Edge> cover;
+    if (!coverPath.empty()) {
+        int coverN = 0;
+        cover = readBinaryCover(coverPath, coverN);
+        if (coverN != static_cast<int>(g.n)) {
+            throw std::invalid_argument("Cover and graph vertex counts differ");
+        }
+    }
+    writeTextGraph(textPath, static_cast<int>(g.n), edges, cover);
+}
+
+#endif // GRAPH_IO_HPP
@@ -0,0 +1,286 @@
+#ifndef SEMI_EXTERNAL_COVER_HPP
+#define SEMI_EXTERNAL_COVER_HPP
+
+#include "graph_io.hpp"
+
+struct SemiExternalOptions {
+    size_t memoryLimit = 0;             // bytes of vertex state plus mapped file window, 0 = no cap
+    size_t windowBytes = 64 << 20;      // file bytes kept mapped behind each of the two cursors
+    unsigned maxPasses = 32;            // augmentation passes after the maximal matching
+};
+
+// what the last SemiExternalCover::solve() did
+struct SemiExternalStats {
+    unsigned passes = 0;            // sequential passes over the file, all of them
+    unsigned augmentingPasses = 0;  // of which spent growing alternating forests
+    uint64_t bytesStreamed = 0;     // file bytes read by those passes
+    uint64_t bytesReleased = 0;     // mapped bytes dropped behind the cursors
+    size_t stateBytes = 0;          // vertex arrays held in memory
+    size_t windowBytes = 0;         // mapped window used per cursor
+
+    int maximalSize = 0;            // matching size after the streaming pass
+    int matchingSize = 0;
+    int augmentations = 0;
+    bool exact = false;             // the last forest proves the matching maximum
+    std::chrono::nanoseconds time{0};
+};
+
+// Minimum edge cover of a binary graph file (graph_io.hpp) that may not fit
+// in memory. Only O(V) state is kept: the mate array and an alternating
+// forest of 13 bytes per vertex. Everything else, the offsets included, is
+// streamed from the mapped file front to back, and the pages behind the
+// two read cursors (offsets and neighbours) are dropped every window, so
+// the mapping stays within memoryLimit:
+//  - one pass builds a greedy maximal matching, at least half of maximum
+//  - each augmenting pass grows an alternating forest rooted at every
+//    exposed vertex by at least one level. An edge between even vertices
+//    of two different trees is an augmenting path; the trees are disjoint,
+//    so all paths of one pass are applied together. Only the trees that
+//    augmented are taken apart; the others go on growing. The forest has
+//    no blossom shrinking, which can stop it early on non-bipartite graphs
+//  - one last pass gives every exposed vertex its first edge
+// The search ends after maxPasses augmenting passes, or once the forest
+// can not grow. If at that point no edge joins two even vertices, the odd
+// vertices form a Tutte-Berge barrier and stats.exact is set; on bipartite
+// graphs that always happens given enough passes.
+class SemiExternalCover {
+private:
+    static constexpr uint8_t even = 1, odd = 2, spent = 4;   // spent marks a root whose tree augmented
+
+    MappedFile file;
+    SemiExternalOptions options;
+    uint32_t n = 0;
+    uint64_t slots = 0;
+    const uint32_t* offsets = nullptr;
+    const uint32_t* neighbors = nullptr;
+
+    std::vector<int> mate;
+    std::vector<int> parent;        // of an odd vertex, the even vertex that reached it
+    std::vector<int> root;          // tree of an even or odd vertex
+    std::vector<uint8_t> label;
+    SemiExternalStats last;
+
+    size_t byteOffset(const uint32_t* p) const {
+        return static_cast<size_t>(reinterpret_cast<const unsigned char*>(p) - file.data());
+    }
+
+    // Calls fn(u, first, last) on every row in vertex order. Pages behind
+    // both cursors are released once a window has been consumed.
+    template <typename Fn>
+    void pass(Fn&& fn) {
+        size_t window = last.windowBytes;
+        size_t offsetsDone = byteOffset(offsets), neighborsDone = byteOffset(neighbors);
+        for (uint32_t u = 0; u < n; u++) {
+            fn(u, neighbors + offsets[u], neighbors + offsets[u + 1]);
+            size_t offsetsAt = byteOffset(offsets + u + 1), neighborsAt = byteOffset(neighbors + offsets[u + 1]);
+            if (offsetsAt - offsetsDone >= window) {
+                file.release(offsetsDone, offsetsAt);
+                last.bytesReleased += offsetsAt - offsetsDone;
+                offsetsDone = offsetsAt;
+            }
+            if (neighborsAt - neighborsDone >= window) {
+                file.release(neighborsDone, neighborsAt);
+                last.bytesReleased += neighborsAt - neighborsDone;
+                neighborsDone = neighborsAt;
+            }
+        }
+        file.release(offsetsDone, byteOffset(offsets + n + 1));
+        file.release(neighborsDone, byteOffset(neighbors + slots));
+        last.bytesReleased += byteOffset(offsets + n + 1) - offsetsDone + byteOffset(neighbors + slots) - neighborsDone;
+        last.bytesStreamed += (static_cast<uint64_t>(n) + 1 + slots) * 4;
+        last.passes++;
+    }
+
+    // checks the rows while matching greedily
+    void maximalMatching() {
+        pass([&](uint32_t u, const uint32_t* first, const uint32_t* end) {
+            if (first == end) {
+                throw std::invalid_argument("Graph contains isolated vertices - edge cover impossible");
+            }
+            if (end < first || byteOffset(end) > byteOffset(neighbors + slots)) {
+                throw std::invalid_argument("Malformed binary graph file");
+            }
+            for (const uint32_t* p = first; p < end; p++) {
+                if (*p >= n) {
+                    throw std::invalid_argument("Invalid vertex index");
+                }
+                if (mate[u] == -1 && *p != u && mate[*p] == -1) {
+                    mate[u] = static_cast<int>(*p);
+                    mate[*p] = static_cast<int>(u);
+                    last.matchingSize++;
+                }
+            }
+        });
+    }
+
+    void resetForest() {
+        for (uint32_t v = 0; v < n; v++) {
+            label[v] = mate[v] == -1 ? even : 0;
+            root[v] = static_cast<int>(v);
+            parent[v] = -1;
+        }
+    }
+
+    // the trees that augmented are unlabelled, all of their vertices now
+    // being matched; the other trees keep growing where they were
+    void dissolveSpent() {
+        for (uint32_t v = 0; v < n; v++) {
+            if (label[v] != 0 && (label[root[v]] & spent) && root[v] != static_cast<int>(v)) label[v] = 0;
+        }
+        for (uint32_t v = 0; v < n; v++) {
+            if (label[v] & spent) label[v] = 0;
+        }
+    }
+
+    // flips the tree path from the even vertex x up to its root; x is
+    // left for the caller to match
+    void flipToRoot(int x) {
+        int o = mate[x];
+        while (o != -1) {
+            int p = parent[o];
+            int next = mate[p];
+            mate[o] = p;
+            mate[p] = o;
+            o = next;
+        }
+    }
+
+    // Grows the forest a pass at a time and applies the augmenting paths
+    // each pass finds; returns once the forest is stuck or out of passes
+    void augment() {
+        std::vector<std::pair<int, int>> bridges;   // at most one per exposed vertex
+        resetForest();
+        while (last.augmentingPasses < options.maxPasses && last.matchingSize < static_cast<int>(n / 2)) {
+            bool grew = false, blossom = false;
+            bridges.clear();
+            pass([&](uint32_t u, const uint32_t* first, const uint32_t* end) {
+                if (!(label[u] & even) || (label[root[u]] & spent)) return;
+                for (const uint32_t* p = first; p < end; p++) {
+                    uint32_t v = *p;
+                    if (label[v] == 0) {
+                        // matched and not reached yet: v is odd, its mate even
+                        int w = mate[v];
+                        label[v] = odd;
+                        parent[v] = static_cast<int>(u);
+                        root[v] = root[w] = root[u];
+                        label[w] = even;
+                        grew = true;
+                    } else if ((label[v] & even) && v != u) {
+                        if (root[v] == root[u]) {
+                            blossom = true;
+                        } else if (!(label[root[v]] & spent)) {
+                            bridges.push_back({static_cast<int>(u), static_cast<int>(v)});
+                            label[root[u]] |= spent;
+                            label[root[v]] |= spent;
+                            return;
+                        }
+                    }
+                }
+            });
+            last.augmentingPasses++;
+
+            if (!bridges.empty()) {
+                for (const auto& bridge : bridges) {
+                    flipToRoot(bridge.first);
+                    flipToRoot(bridge.second);
+                    mate[bridge.first] = bridge.second;
+                    mate[bridge.second] = bridge.first;
+                }
+                last.matchingSize += static_cast<int>(bridges.size());
+                last.augmentations += static_cast<int>(bridges.size());
+                dissolveSpent();
+            } else if (!grew) {
+                last.exact = !blossom;
+                return;
+            }
+        }
+        last.exact = last.matchingSize == static_cast<int>(n / 2);
+    }
+
+public:
+    explicit SemiExternalCover(const std::string& path, SemiExternalOptions options = {})
+        : file(path), options(options) {
+        BinaryFormat::requireLittleEndian();
+        BinaryFormat::GraphHeader h;
+        if (file.size() < sizeof(h)) {
+            throw std::invalid_argument("Not a binary graph file");
+        }
+        std::memcpy(&h, file.data(), sizeof(h));
+        BinaryFormat::checkGraphHeader(h, file.size());
+        if (h.n > static_cast<uint32_t>(INT_MAX)) {
+            throw std::invalid_argument("Too many vertices");
+        }
+        n = h.n;
+        slots = h.slots;
+        offsets = reinterpret_cast<const uint32_t*>(file.data() + sizeof(h));
+        neighbors = offsets + n + 1;
+        if (offsets[0] != 0 || offsets[n] != slots) {
+            throw std::invalid_argument("Malformed binary graph file");
+        }
+        file.adviseSequential();
+    }
+
+    SemiExternalCover(const SemiExternalCover&) = delete;
+    SemiExternalCover& operator=(const SemiExternalCover&) = delete;
+
+    uint32_t vertexCount() const { return n; }
+
+    // vertex arrays solve() allocates
+    size_t stateBytes() const {
+        return static_cast<size_t>(n) * (3 * sizeof(int) + sizeof(uint8_t));
+    }
+
+    // Throws std::invalid_argument when memoryLimit can not hold the vertex
+    // state and one page per cursor
+    std::vector<Edge> solve(SemiExternalStats& stats) {
+        auto start = std::chrono::steady_clock::now();
+        last = SemiExternalStats();
+        last.stateBytes = stateBytes();
+        last.windowBytes = std::max<size_t>(options.windowBytes, 1);
+        if (options.memoryLimit != 0) {
+            size_t page = 4096;
+#ifndef _WIN32
+            page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+            if (options.memoryLimit < last.stateBytes + 2 * page) {
+                throw std::invalid_argument("Memory limit is below the " + std::to_string(last.stateBytes) +
+                                            " bytes of vertex state");
+            }
+            last.windowBytes = std::min(last.windowBytes, (options.memoryLimit - last.stateBytes) / 2);
+        }
+
+        mate.assign(n, -1);
+        maximalMatching();
+        last.maximalSize = last.matchingSize;
+        parent.resize(n);
+        root.resize(n);
+        label.resize(n);
+        augment();
+        std::vector<int>().swap(parent);
+        std::vector<int>().swap(root);
+        std::vector<uint8_t>().swap(label);
+
+        std::vector<Edge> cover;
+        cover.reserve(n - static_cast<uint32_t>(last.matchingSize));
+        pass([&](uint32_t u, const uint32_t* first, const uint32_t*) {
+            if (mate[u] == -1) {
+                cover.push_back(Edge(static_cast<int>(u), static_cast<int>(*first)));
+            } else if (static_cast<int>(u) < mate[u]) {
+                cover.push_back(Edge(static_cast<int>(u), mate[u]));
+            }
+        });
+        last.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        stats = last;
+        return cover;
+    }
+
+    std::vector<Edge> solve() {
+        SemiExternalStats stats;
+        return solve(stats);
+    }
+
+    // the matching of the last solve, -1 for exposed vertices
+    const std::vector<int>& mates() const { return mate; }
+};
+
+#endif // SEMI_EXTERNAL_COVER_HPP
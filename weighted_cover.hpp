@@ -0,0 +1,753 @@
+#ifndef WEIGHTED_EDGE_COVER_HPP
+#define WEIGHTED_EDGE_COVER_HPP
+
+#include <queue>
+#include "graph.hpp"
+
+struct WeightedEdge {
+    int u, v;
+    int64_t weight;
+    WeightedEdge(int u = 0, int v = 0, int64_t weight = 0) : u(u), v(v), weight(weight) {}
+
+    bool operator==(const WeightedEdge& other) const {
+        return weight == other.weight &&
+               ((u == other.u && v == other.v) || (u == other.v && v == other.u));
+    }
+};
+
+// Maximum-weight matching on general graphs: Edmonds' primal-dual blossom
+// algorithm. Alternating trees grow from every exposed vertex over tight
+// edges (zero slack), odd cycles are contracted into blossoms and, when no
+// tight edge is left, the duals move by the largest step that keeps them
+// feasible; it ends once the exposed vertices' duals reach zero.
+//
+// Unlike Galil's stages, which throw every tree away after each
+// augmentation and regrow the forest from scratch, the trees persist: an
+// augmentation only dissolves the two trees it joined. Dual steps are not
+// applied vertex by vertex either. The duals of a labelled top-level
+// blossom drift with a clock that sums the steps and are written back when
+// its label changes, and the next step's candidates (edges from S to free
+// vertices, edges between S blossoms, T blossom duals) wait in heaps keyed
+// on that clock, so a step costs a few heap operations.
+//
+// Edge k has endpoints 2k and 2k + 1; mate[v] is the endpoint across v's
+// matched edge. Weights are integers, so every slack stays even and the
+// dual arithmetic is exact.
+class WeightedBlossomMatcher {
+private:
+    // a step candidate: its slack or dual plus the clock times its rate, so
+    // the key stays put while the value drops with the clock
+    using Candidate = std::pair<int64_t, int>;
+    using CandidateHeap = std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>>;
+
+    int n;
+    const std::vector<WeightedEdge>& edges;
+
+    std::vector<int> endpoint;                  // endpoint p -> vertex
+    std::vector<int> adjStart, adjEnds;         // v -> remote endpoints of its edges, CSR
+    std::vector<int> mate;
+
+    // indexed by vertex or blossom (n .. 2n - 1)
+    std::vector<int> label;         // 0 free, 1 S, 2 T; 5 marks a scan in progress
+    std::vector<int> labelEnd;      // endpoint through which the label was given
+    std::vector<int> inBlossom;     // vertex -> top-level blossom
+    std::vector<int> blossomParent, blossomBase;
+    std::vector<std::vector<int>> blossomChilds, blossomEndps;
+    std::vector<int64_t> dual;      // for a labelled top-level blossom, as of since[]
+    std::vector<int64_t> since;     // clock when its duals were last written back
+    std::vector<int> treeRoot;      // labelled top-level blossom -> exposed vertex of its tree
+    std::vector<std::vector<int>> treeMembers;  // exposed vertex -> blossoms labelled in its tree
+    std::vector<int> unusedBlossoms;
+
+    int64_t clock = 0;              // sum of the dual steps so far
+    int64_t initialDual = 0;        // every vertex starts here; exposed ones stay at initialDual - clock
+
+    std::vector<uint8_t> allowEdge;     // tight edges already found
+    std::vector<int> queue;             // S vertices still to scan
+    std::vector<int> scanPath, leafBuffer, freed;
+    CandidateHeap toFree, betweenS, shrinking;
+
+    static bool isS(int l) { return l == 1 || l == 5; }
+
+    // current dual of vertex v
+    int64_t vertexDual(int v) const {
+        int b = inBlossom[v];
+        if (isS(label[b])) return dual[v] - (clock - since[b]);
+        if (label[b] == 2) return dual[v] + (clock - since[b]);
+        return dual[v];
+    }
+
+    int64_t slack(int k) const {
+        return vertexDual(edges[k].u) + vertexDual(edges[k].v) - 2 * edges[k].weight;
+    }
+
+    // appends the vertices inside blossom b
+    void leaves(int b, std::vector<int>& out) const {
+        if (b < n) {
+            out.push_back(b);
+            return;
+        }
+        std::vector<int> pending(1, b);
+        while (!pending.empty()) {
+            int t = pending.back();
+            pending.pop_back();
+            for (auto it = blossomChilds[t].rbegin(); it != blossomChilds[t].rend(); ++it) {
+                if (*it < n) {
+                    out.push_back(*it);
+                } else {
+                    pending.push_back(*it);
+                }
+            }
+        }
+    }
+
+    // writes the drift of top-level blossom b into its duals; called before
+    // its label or its place in the blossom tree changes
+    void settle(int b) {
+        int64_t drift = clock - since[b];
+        since[b] = clock;
+        if (drift == 0 || (label[b] != 1 && label[b] != 2)) return;
+        if (label[b] == 1) drift = -drift;
+        if (b < n) {
+            dual[b] += drift;
+            return;
+        }
+        std::vector<int> inside;
+        leaves(b, inside);
+        for (int x : inside) dual[x] += drift;
+        dual[b] -= drift;
+    }
+
+    // position i of a cyclic child list, i may be negative
+    static int cyclic(int i, int size) {
+        return ((i % size) + size) % size;
+    }
+
+    static int indexOf(const std::vector<int>& list, int value) {
+        return static_cast<int>(std::find(list.begin(), list.end(), value) - list.begin());
+    }
+
+    // marks top-level blossom b as labelled in the tree of root
+    void joinTree(int b, int root) {
+        since[b] = clock;
+        treeRoot[b] = root;
+        treeMembers[root].push_back(b);
+        if (b >= n && label[b] == 2) shrinking.push({dual[b] + clock, b});
+    }
+
+    // labels w (and its top-level blossom) t, reached through endpoint p; a
+    // T blossom passes S on to the mate of its base
+    void assignLabel(int w, int t, int p, int root) {
+        int b = inBlossom[w];
+        label[w] = label[b] = t;
+        labelEnd[w] = labelEnd[b] = p;
+        joinTree(b, root);
+        if (t == 1) {
+            leaves(b, queue);
+        } else if (t == 2) {
+            int base = blossomBase[b];
+            assignLabel(endpoint[mate[base]], 1, mate[base] ^ 1, root);
+        }
+    }
+
+    // walks up from the S vertices v and w at once; returns the base of the
+    // new blossom they close, or -1 if they lie in different trees
+    int scanBlossom(int v, int w) {
+        scanPath.clear();
+        int base = -1;
+        while (v != -1 || w != -1) {
+            int b = inBlossom[v];
+            if (label[b] & 4) {
+                base = blossomBase[b];
+                break;
+            }
+            scanPath.push_back(b);
+            label[b] = 5;
+            if (labelEnd[b] == -1) {
+                v = -1;
+            } else {
+                v = endpoint[labelEnd[b]];
+                b = inBlossom[v];
+                v = endpoint[labelEnd[b]];
+            }
+            if (w != -1) std::swap(v, w);
+        }
+        for (int b : scanPath) label[b] = 1;
+        return base;
+    }
+
+    // contracts the odd cycle closed by edge k into a new S blossom
+    void addBlossom(int base, int k) {
+        int v = edges[k].u, w = edges[k].v;
+        int bb = inBlossom[base], bv = inBlossom[v], bw = inBlossom[w];
+        int b = unusedBlossoms.back();
+        unusedBlossoms.pop_back();
+        blossomBase[b] = base;
+        blossomParent[b] = -1;
+        blossomParent[bb] = b;
+
+        std::vector<int>& path = blossomChilds[b];
+        std::vector<int>& endps = blossomEndps[b];
+        path.clear();
+        endps.clear();
+        while (bv != bb) {
+            blossomParent[bv] = b;
+            path.push_back(bv);
+            endps.push_back(labelEnd[bv]);
+            v = endpoint[labelEnd[bv]];
+            bv = inBlossom[v];
+        }
+        path.push_back(bb);
+        std::reverse(path.begin(), path.end());
+        std::reverse(endps.begin(), endps.end());
+        endps.push_back(2 * k);
+        while (bw != bb) {
+            blossomParent[bw] = b;
+            path.push_back(bw);
+            endps.push_back(labelEnd[bw] ^ 1);
+            w = endpoint[labelEnd[bw]];
+            bw = inBlossom[w];
+        }
+        for (int sub : path) settle(sub);
+
+        label[b] = 1;
+        labelEnd[b] = labelEnd[bb];
+        dual[b] = 0;
+        joinTree(b, treeRoot[bb]);
+        leafBuffer.clear();
+        leaves(b, leafBuffer);
+        for (int x : leafBuffer) {
+            // former T vertices become S and get scanned
+            if (label[inBlossom[x]] == 2) queue.push_back(x);
+            inBlossom[x] = b;
+        }
+    }
+
+    // queues the edges from the vertices of blossom b, which just became
+    // free, to S vertices as step candidates
+    void offerFree(int b) {
+        leafBuffer.clear();
+        leaves(b, leafBuffer);
+        for (int x : leafBuffer) {
+            for (int i = adjStart[x]; i < adjStart[x + 1]; i++) {
+                int k = adjEnds[i] / 2;
+                if (isS(label[inBlossom[endpoint[adjEnds[i]]]])) toFree.push({slack(k) + clock, k});
+            }
+        }
+    }
+
+    // dissolves blossom b into its children; a T blossom expanded mid-tree
+    // relabels the children along the even path to its entry point
+    void expandBlossom(int b, bool unlabelled) {
+        settle(b);
+        for (int s : blossomChilds[b]) {
+            blossomParent[s] = -1;
+            since[s] = clock;
+            if (s < n) {
+                inBlossom[s] = s;
+            } else if (unlabelled && dual[s] == 0) {
+                expandBlossom(s, unlabelled);
+            } else {
+                leafBuffer.clear();
+                leaves(s, leafBuffer);
+                for (int x : leafBuffer) inBlossom[x] = s;
+            }
+        }
+
+        if (!unlabelled && label[b] == 2) {
+            std::vector<int>& childs = blossomChilds[b];
+            std::vector<int>& endps = blossomEndps[b];
+            int size = static_cast<int>(childs.size());
+            int root = treeRoot[b];
+            int entryChild = inBlossom[endpoint[labelEnd[b] ^ 1]];
+            int j = indexOf(childs, entryChild);
+            int step, trick;
+            if (j & 1) {
+                j -= size;
+                step = 1;
+                trick = 0;
+            } else {
+                step = -1;
+                trick = 1;
+            }
+
+            int p = labelEnd[b];
+            while (j != 0) {
+                label[endpoint[p ^ 1]] = 0;
+                label[endpoint[endps[cyclic(j - trick, size)] ^ trick ^ 1]] = 0;
+                assignLabel(endpoint[p ^ 1], 2, p, root);
+                allowEdge[endps[cyclic(j - trick, size)] / 2] = 1;
+                j += step;
+                p = endps[cyclic(j - trick, size)] ^ trick;
+                allowEdge[p / 2] = 1;
+                j += step;
+            }
+
+            // the base child keeps T without passing S on to its mate
+            int bv = childs[cyclic(j, size)];
+            label[endpoint[p ^ 1]] = label[bv] = 2;
+            labelEnd[endpoint[p ^ 1]] = labelEnd[bv] = p;
+            joinTree(bv, root);
+
+            j += step;
+            while (childs[cyclic(j, size)] != entryChild) {
+                bv = childs[cyclic(j, size)];
+                if (label[bv] == 1) {
+                    j += step;
+                    continue;
+                }
+                leafBuffer.clear();
+                leaves(bv, leafBuffer);
+                int reached = -1;
+                for (int x : leafBuffer) {
+                    if (label[x] != 0) {
+                        reached = x;
+                        break;
+                    }
+                }
+                if (reached != -1) {
+                    label[reached] = 0;
+                    label[endpoint[mate[blossomBase[bv]]]] = 0;
+                    assignLabel(reached, 2, labelEnd[reached], treeRoot[inBlossom[endpoint[labelEnd[reached]]]]);
+                }
+                j += step;
+            }
+
+            // children left free were T until now, so nothing offered
+            // their edges to the S vertices around them yet
+            for (int s : childs) {
+                if (label[s] == 0) offerFree(s);
+            }
+        }
+
+        label[b] = labelEnd[b] = -1;
+        blossomChilds[b].clear();
+        blossomEndps[b].clear();
+        blossomBase[b] = -1;
+        unusedBlossoms.push_back(b);
+    }
+
+    // flips the even path inside blossom b from its base to vertex v, which
+    // becomes the new base
+    void augmentBlossom(int b, int v) {
+        int t = v;
+        while (blossomParent[t] != b) t = blossomParent[t];
+        if (t >= n) augmentBlossom(t, v);
+
+        std::vector<int>& childs = blossomChilds[b];
+        std::vector<int>& endps = blossomEndps[b];
+        int size = static_cast<int>(childs.size());
+        int i = indexOf(childs, t);
+        int j = i;
+        int step, trick;
+        if (i & 1) {
+            j -= size;
+            step = 1;
+            trick = 0;
+        } else {
+            step = -1;
+            trick = 1;
+        }
+        while (j != 0) {
+            j += step;
+            t = childs[cyclic(j, size)];
+            int p = endps[cyclic(j - trick, size)] ^ trick;
+            if (t >= n) augmentBlossom(t, endpoint[p]);
+            j += step;
+            t = childs[cyclic(j, size)];
+            if (t >= n) augmentBlossom(t, endpoint[p ^ 1]);
+            mate[endpoint[p]] = p ^ 1;
+            mate[endpoint[p ^ 1]] = p;
+        }
+        std::rotate(childs.begin(), childs.begin() + i, childs.end());
+        std::rotate(endps.begin(), endps.begin() + i, endps.end());
+        blossomBase[b] = blossomBase[childs[0]];
+    }
+
+    // flips the augmenting path through edge k between two S trees
+    void augmentMatching(int k) {
+        int starts[2][2] = {{edges[k].u, 2 * k + 1}, {edges[k].v, 2 * k}};
+        for (const auto& start : starts) {
+            int s = start[0], p = start[1];
+            for (;;) {
+                int bs = inBlossom[s];
+                if (bs >= n) augmentBlossom(bs, s);
+                mate[s] = p;
+                if (labelEnd[bs] == -1) break;
+                int t = endpoint[labelEnd[bs]];
+                int bt = inBlossom[t];
+                s = endpoint[labelEnd[bt]];
+                int j = endpoint[labelEnd[bt] ^ 1];
+                if (bt >= n) augmentBlossom(bt, j);
+                mate[j] = labelEnd[bt];
+                p = labelEnd[bt] ^ 1;
+            }
+        }
+    }
+
+    // clears every label of blossom b, its sub-blossoms and its vertices
+    void unlabel(int b) {
+        label[b] = 0;
+        labelEnd[b] = -1;
+        if (b < n) {
+            freed.push_back(b);
+            return;
+        }
+        for (int s : blossomChilds[b]) unlabel(s);
+    }
+
+    // drops the tree of root, whose exposed vertex an augmentation just
+    // matched; its vertices turn free and the other trees stay as they are
+    void dissolveTree(int root) {
+        freed.clear();
+        std::vector<int>& members = treeMembers[root];
+        for (size_t i = 0; i < members.size(); i++) {
+            int b = members[i];
+            if (blossomParent[b] != -1 || treeRoot[b] != root || (label[b] != 1 && label[b] != 2)) {
+                members[i--] = members.back();
+                members.pop_back();
+                continue;
+            }
+            settle(b);
+            unlabel(b);
+            treeRoot[b] = -1;
+        }
+        // blossoms whose dual dropped to zero are no use any more
+        for (int b : members) {
+            if (b >= n && blossomParent[b] == -1 && blossomBase[b] >= 0 && dual[b] == 0) {
+                expandBlossom(b, true);
+            }
+        }
+        members.clear();
+
+        // the tree's edges may be tight no longer, and edges to the S
+        // vertices of other trees become step candidates; a vertex inside
+        // a T blossom that one of ours reached forgets it
+        for (int x : freed) {
+            for (int i = adjStart[x]; i < adjStart[x + 1]; i++) {
+                int k = adjEnds[i] / 2;
+                int w = endpoint[adjEnds[i]];
+                allowEdge[k] = 0;
+                if (isS(label[inBlossom[w]])) {
+                    toFree.push({slack(k) + clock, k});
+                } else if (inBlossom[w] != w && label[w] == 2 && labelEnd[w] == (adjEnds[i] ^ 1)) {
+                    label[w] = 0;
+                    labelEnd[w] = -1;
+                }
+            }
+        }
+    }
+
+    // scans S vertices until an augmentation; false when the queue runs dry
+    bool growTrees() {
+        while (!queue.empty()) {
+            int v = queue.back();
+            queue.pop_back();
+            if (label[inBlossom[v]] != 1) continue;     // its tree was dissolved
+            for (int i = adjStart[v]; i < adjStart[v + 1]; i++) {
+                int p = adjEnds[i];
+                int k = p / 2;
+                int w = endpoint[p];
+                if (inBlossom[v] == inBlossom[w]) continue;
+                int64_t kslack = 0;
+                if (!allowEdge[k]) {
+                    kslack = slack(k);
+                    if (kslack <= 0) allowEdge[k] = 1;
+                }
+                if (allowEdge[k]) {
+                    if (label[inBlossom[w]] == 0) {
+                        assignLabel(w, 2, p ^ 1, treeRoot[inBlossom[v]]);
+                    } else if (label[inBlossom[w]] == 1) {
+                        int base = scanBlossom(v, w);
+                        if (base >= 0) {
+                            addBlossom(base, k);
+                        } else {
+                            int rootV = treeRoot[inBlossom[v]], rootW = treeRoot[inBlossom[w]];
+                            augmentMatching(k);
+                            dissolveTree(rootV);
+                            dissolveTree(rootW);
+                            return true;
+                        }
+                    } else if (label[w] == 0) {
+                        // w sits inside a T blossom; remember how it was reached
+                        label[w] = 2;
+                        labelEnd[w] = p ^ 1;
+                    }
+                } else if (label[inBlossom[w]] == 1) {
+                    betweenS.push({kslack + 2 * clock, k});
+                } else if (label[inBlossom[w]] == 0) {
+                    toFree.push({kslack + clock, k});
+                }
+            }
+        }
+        return false;
+    }
+
+    // the least live candidate of heap, or -1 if none is left; value(id, out)
+    // says whether the candidate still applies and what it is now. Dead
+    // entries are dropped, and one whose value moved off its key (its
+    // blossom was relabelled in between) goes back in under the right key
+    template <typename Value>
+    int leastCandidate(CandidateHeap& heap, int rate, int64_t& best, Value value) {
+        while (!heap.empty()) {
+            Candidate top = heap.top();
+            int64_t now;
+            if (!value(top.second, now)) {
+                heap.pop();
+            } else if (now + rate * clock != top.first) {
+                heap.pop();
+                heap.push({now + rate * clock, top.second});
+            } else {
+                best = now;
+                return top.second;
+            }
+        }
+        return -1;
+    }
+
+    // moves the duals by the largest feasible step; returns false once the
+    // exposed vertices' duals reach zero, i.e. no augmentation can add weight
+    bool adjustDuals() {
+        int type = 1;
+        int64_t delta = initialDual - clock;
+        int deltaEdge = -1, deltaBlossom = -1;
+        int64_t d = 0;
+
+        // free vertex to S vertex
+        int k = leastCandidate(toFree, 1, d, [&](int e, int64_t& now) {
+            int bu = inBlossom[edges[e].u], bv = inBlossom[edges[e].v];
+            if (!((label[bu] == 0 && label[bv] == 1) || (label[bu] == 1 && label[bv] == 0))) return false;
+            now = slack(e);
+            return true;
+        });
+        if (k != -1 && d < delta) {
+            delta = d;
+            type = 2;
+            deltaEdge = k;
+        }
+        // S blossom to S blossom
+        k = leastCandidate(betweenS, 2, d, [&](int e, int64_t& now) {
+            int bu = inBlossom[edges[e].u], bv = inBlossom[edges[e].v];
+            if (bu == bv || label[bu] != 1 || label[bv] != 1) return false;
+            now = slack(e);
+            return true;
+        });
+        if (k != -1 && d / 2 < delta) {
+            delta = d / 2;
+            type = 3;
+            deltaEdge = k;
+        }
+        // T blossom whose dual would go negative
+        int b = leastCandidate(shrinking, 1, d, [&](int t, int64_t& now) {
+            if (blossomBase[t] < 0 || blossomParent[t] != -1 || label[t] != 2) return false;
+            now = dual[t] - (clock - since[t]);
+            return true;
+        });
+        if (b != -1 && d < delta) {
+            delta = d;
+            type = 4;
+            deltaBlossom = b;
+        }
+
+        clock += delta;
+        if (type == 1) return false;
+        if (type == 4) {
+            expandBlossom(deltaBlossom, false);
+        } else {
+            allowEdge[deltaEdge] = 1;
+            int i = edges[deltaEdge].u;
+            if (label[inBlossom[i]] == 0) i = edges[deltaEdge].v;
+            queue.push_back(i);
+        }
+        return true;
+    }
+
+public:
+    // edges must not contain self-loops
+    WeightedBlossomMatcher(int n, const std::vector<WeightedEdge>& edges)
+        : n(n), edges(edges), endpoint(2 * edges.size()), adjStart(n + 1, 0), adjEnds(2 * edges.size()),
+          mate(n, -1), label(2 * n, 0), labelEnd(2 * n, -1), inBlossom(n), blossomParent(2 * n, -1),
+          blossomBase(2 * n, -1), blossomChilds(2 * n), blossomEndps(2 * n), dual(2 * n, 0),
+          since(2 * n, 0), treeRoot(2 * n, -1), treeMembers(n), allowEdge(edges.size(), 0) {
+        for (size_t k = 0; k < edges.size(); k++) {
+            endpoint[2 * k] = edges[k].u;
+            endpoint[2 * k + 1] = edges[k].v;
+            adjStart[edges[k].u + 1]++;
+            adjStart[edges[k].v + 1]++;
+            initialDual = std::max(initialDual, edges[k].weight);
+        }
+        for (int v = 0; v < n; v++) adjStart[v + 1] += adjStart[v];
+        std::vector<int> fill(adjStart.begin(), adjStart.end() - 1);
+        for (size_t k = 0; k < edges.size(); k++) {
+            adjEnds[fill[edges[k].u]++] = static_cast<int>(2 * k + 1);
+            adjEnds[fill[edges[k].v]++] = static_cast<int>(2 * k);
+        }
+        for (int v = 0; v < n; v++) {
+            inBlossom[v] = v;
+            blossomBase[v] = v;
+            dual[v] = initialDual;
+        }
+        for (int b = 2 * n - 1; b >= n; b--) unusedBlossoms.push_back(b);
+    }
+
+    // computes a maximum-weight matching; returns the number of augmentations
+    int run() {
+        int augmentations = 0;
+        for (int v = 0; v < n; v++) {
+            if (mate[v] == -1 && label[inBlossom[v]] == 0) assignLabel(v, 1, -1, v);
+        }
+        for (;;) {
+            if (growTrees()) {
+                augmentations++;
+            } else if (!adjustDuals()) {
+                break;
+            }
+        }
+        return augmentations;
+    }
+
+    // index of v's matched edge, or -1
+    int matchedEdge(int v) const { return mate[v] == -1 ? -1 : mate[v] / 2; }
+};
+
+struct WeightedCoverResult {
+    std::vector<WeightedEdge> edges;
+    int64_t weight = 0;
+    int matchingSize = 0;       // edges that came from the matching
+
+    std::chrono::nanoseconds matchingTime{0};
+    std::chrono::nanoseconds completionTime{0};
+};
+
+// Minimum-weight edge cover. Let mu(v) be the weight of the lightest edge at
+// v. A cover made of a matching M plus the lightest edge of every vertex M
+// leaves exposed costs sum(mu) - sum over M of (mu(u) + mu(v) - w(u, v)),
+// and a minimum-weight cover has this form. So the solver finds a
+// maximum-weight matching on these gains, over the edges whose gain is
+// positive, and completes it with lightest edges. With unit weights every
+// gain is 1 and the result is a minimum edge cover, as from MinEdgeCover.
+//
+// Weights must be integers from 0 to maxWeight; scale fractional costs. The
+// bound keeps the gains, the matcher's duals and its heap keys, which reach
+// a few times the largest weight, inside int64_t. The lightest weights of
+// all vertices must also sum within int64_t, since no cover costs more.
+class WeightedMinEdgeCover {
+private:
+    int n;
+    std::vector<WeightedEdge> edges;
+    std::vector<int> lightest;      // vertex -> index of its lightest edge
+
+public:
+    static constexpr int64_t maxWeight = INT64_MAX / 16;
+
+    WeightedMinEdgeCover(int vertices, const std::vector<WeightedEdge>& edgeList)
+        : n(vertices), edges(edgeList) {
+        if (vertices <= 0) {
+            throw std::invalid_argument("Number of vertices must be positive");
+        }
+        lightest.assign(n, -1);
+        for (size_t k = 0; k < edges.size(); k++) {
+            const WeightedEdge& e = edges[k];
+            if (e.u < 0 || e.u >= n || e.v < 0 || e.v >= n) {
+                throw std::invalid_argument("Invalid vertex index");
+            }
+            if (e.weight < 0) {
+                throw std::invalid_argument("Edge weights must be non-negative");
+            }
+            if (e.weight > maxWeight) {
+                throw std::invalid_argument("Edge weights must not exceed WeightedMinEdgeCover::maxWeight");
+            }
+            for (int x : {e.u, e.v}) {
+                if (lightest[x] == -1 || e.weight < edges[lightest[x]].weight) {
+                    lightest[x] = static_cast<int>(k);
+                }
+            }
+        }
+        int64_t bound = 0;
+        for (int i = 0; i < n; i++) {
+            if (lightest[i] == -1) {
+                throw std::invalid_argument("Graph contains isolated vertices - edge cover impossible");
+            }
+            if (edges[lightest[i]].weight > INT64_MAX - bound) {
+                throw std::invalid_argument("Edge weights too large: the cover weight would overflow int64_t");
+            }
+            bound += edges[lightest[i]].weight;
+        }
+    }
+
+    std::vector<WeightedEdge> solve() {
+        return solveDetailed().edges;
+    }
+
+    // same as solve(), also reporting the total weight and stage timings
+    WeightedCoverResult solveDetailed() {
+        WeightedCoverResult report;
+        auto start = std::chrono::steady_clock::now();
+
+        // only vertices with a positive-gain edge take part in the matching
+        std::vector<int> local(n, -1);
+        std::vector<WeightedEdge> gains;
+        std::vector<int> source;        // gain edge -> input edge
+        int count = 0;
+        for (size_t k = 0; k < edges.size(); k++) {
+            const WeightedEdge& e = edges[k];
+            if (e.u == e.v) continue;
+            int64_t gain = edges[lightest[e.u]].weight + edges[lightest[e.v]].weight - e.weight;
+            if (gain <= 0) continue;
+            if (local[e.u] == -1) local[e.u] = count++;
+            if (local[e.v] == -1) local[e.v] = count++;
+            gains.push_back(WeightedEdge(local[e.u], local[e.v], gain));
+            source.push_back(static_cast<int>(k));
+        }
+        WeightedBlossomMatcher matcher(count, gains);
+        matcher.run();
+        auto matched = std::chrono::steady_clock::now();
+
+        std::vector<uint8_t> covered(n, 0);
+        for (int i = 0; i < n; i++) {
+            if (local[i] == -1 || covered[i]) continue;
+            int g = matcher.matchedEdge(local[i]);
+            if (g == -1) continue;
+            const WeightedEdge& e = edges[source[g]];
+            report.edges.push_back(e);
+            covered[e.u] = covered[e.v] = 1;
+        }
+        report.matchingSize = static_cast<int>(report.edges.size());
+
+        // exposed vertices take their lightest edge; one that also covers
+        // another exposed vertex has zero gain, so that vertex needs no edge
+        for (int i = 0; i < n; i++) {
+            if (covered[i]) continue;
+            const WeightedEdge& e = edges[lightest[i]];
+            report.edges.push_back(e);
+            covered[e.u] = covered[e.v] = 1;
+        }
+        report.weight = totalWeight(report.edges);
+        auto done = std::chrono::steady_clock::now();
+
+        report.matchingTime = std::chrono::duration_cast<std::chrono::nanoseconds>(matched - start);
+        report.completionTime = std::chrono::duration_cast<std::chrono::nanoseconds>(done - matched);
+        return report;
+    }
+
+    static int64_t totalWeight(const std::vector<WeightedEdge>& cover) {
+        int64_t weight = 0;
+        for (const auto& e : cover) weight += e.weight;
+        return weight;
+    }
+
+    // check if the given set is an edge cover
+    static bool isEdgeCover(int n, const std::vector<WeightedEdge>& cover) {
+        std::vector<uint8_t> covered(n, 0);
+        for (const auto& e : cover) {
+            covered[e.u] = 1;
+            covered[e.v] = 1;
+        }
+        for (int i = 0; i < n; i++) {
+            if (!covered[i]) return false;
+        }
+        return true;
+    }
+};
+
+#endif // WEIGHTED_EDGE_COVER_HPP